@@ -0,0 +1,69 @@
+// Public Domain
+//
+// bench_local.h -- headless game module benchmark
+//
+
+#include "../game/g_local.h"
+
+// extension syscalls answered through trap_GetValue
+#define BENCH_GET_VALUE			700
+#define BENCH_MICROSECONDS		701
+
+// box world the fake clients run around in
+#define BENCH_WORLD_SIZE		2048
+#define BENCH_WORLD_HEIGHT		512
+
+// same as the engine collision code
+#define SURFACE_CLIP_EPSILON	0.125f
+
+//
+// bench_syscalls.c
+//
+extern int			benchTime;		// server time, also returned by trap_Milliseconds
+extern usercmd_t	benchCmds[ MAX_CLIENTS ];
+extern qboolean		benchVerbose;
+
+intptr_t QDECL Bench_Syscall( intptr_t command, ... );
+void Bench_ResetServer( const char *entityString );
+void Bench_SetEntityString( const char *entityString );
+void Bench_SetCvar( const char *name, const char *value );
+void Bench_SetUserinfo( int clientNum, const char *userinfo );
+void Bench_SetCommand( const char *text );
+playerState_t *Bench_PlayerState( int clientNum );
+int Bench_Microseconds( void );
+void Bench_Trace( trace_t *tr, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask );
+int Bench_PointContents( const vec3_t point, int passEntityNum );
+int Bench_ServerCommands( void );
+
+void Bench_SetArgs( int argc, char **argv );
+
+//
+// bench_main.c
+//
+void Bench_ApplyOverrides( void );
+void Bench_PrintHeader( void );
+void Bench_PrintResult( int numPlayers, int *samples, int numFrames, int frags );
+
+//
+// bench_replay.c
+//
+typedef struct {
+	usercmd_t	*cmds;
+	int			numCmds;
+	int			maxCmds;
+} benchCmdStream_t;
+
+qboolean Bench_Replay( const char *filename );
+int Bench_LoadUsercmds( const char *filename, benchCmdStream_t *streams );
+
+//
+// bench_pmove.c
+//
+qboolean Bench_Pmove( int numPlayers, int numCmds, int seed, const char *replay );
+void Bench_PmoveHeader( void );
+
+//
+// game module entry points, linked in statically
+//
+void dllEntry( dllSyscall_t syscallptr );
+intptr_t vmMain( int command, int arg0, int arg1, int arg2 );
@@ -0,0 +1,393 @@
+// Public Domain
+//
+// bench_main.c -- runs the game module headless with scripted clients
+//
+// usage: qabench [-players <n>] [-frames <n>] [-fps <n>] [-seed <n>] [-replay <file>]
+//                [-pmove] [-v] [+set <cvar> <value>]
+//
+// -players can be repeated, the default is to run 8, 32 and 64 players.
+// All players fight in the same box room: they run around, jump, and fire
+// at each other, so the numbers include weapons, damage and respawns.
+// Everything except the wall clock is driven by the simulated server time,
+// so a given seed always plays out the same match.
+//
+// -replay plays back a g_recordCmds recording instead, see bench_replay.c
+// -pmove only runs player movement, -frames is the commands per player,
+// see bench_pmove.c
+//
+
+#include "bench_local.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MAX_RUNS			8
+#define MAX_OVERRIDES		32
+
+typedef struct {
+	unsigned int	seed;
+	int				nextChange;		// benchTime to pick new movement
+	int				forwardmove;
+	int				rightmove;
+	int				jump;
+	int				attack;
+	int				weapon;
+	float			aimError;		// degrees
+} benchPlayer_t;
+
+static benchPlayer_t	players[ MAX_CLIENTS ];
+static char				entityString[ 0x10000 ];
+
+static const char		*overrides[ MAX_OVERRIDES ][ 2 ];
+static int				numOverrides;
+
+
+static unsigned int Bench_Rand( unsigned int *seed ) {
+	*seed = *seed * 1103515245u + 12345u;
+	return ( *seed >> 16 ) & 0x7fff;
+}
+
+
+static int QDECL Bench_CompareInt( const void *a, const void *b ) {
+	return *(const int *)a - *(const int *)b;
+}
+
+
+/*
+================
+Bench_ApplyOverrides
+
+Sets the cvars given with +set, after the bench defaults
+================
+*/
+void Bench_ApplyOverrides( void ) {
+	int i;
+
+	for ( i = 0; i < numOverrides; i++ ) {
+		Bench_SetCvar( overrides[i][0], overrides[i][1] );
+	}
+}
+
+
+void Bench_PrintHeader( void ) {
+	printf( "%7s %7s %8s %9s %7s %7s %7s %7s %7s %8s\n",
+		"players", "frames", "msec", "fps", "avg", "min", "p50", "p99", "max", "frags" );
+}
+
+
+/*
+================
+Bench_PrintResult
+
+Sorts the samples
+================
+*/
+void Bench_PrintResult( int numPlayers, int *samples, int numFrames, int frags ) {
+	float	sum;
+	int		i, total;
+
+	if ( numFrames < 1 ) {
+		printf( "%7i %7i\n", numPlayers, 0 );
+		return;
+	}
+
+	sum = 0;
+	for ( i = 0; i < numFrames; i++ ) {
+		sum += samples[i];
+	}
+	qsort( samples, numFrames, sizeof( samples[0] ), Bench_CompareInt );
+	total = (int)( sum / 1000.0f );
+
+	printf( "%7i %7i %8i %9.1f %7i %7i %7i %7i %7i %8i\n",
+		numPlayers, numFrames, total, total ? numFrames * 1000.0f / total : 0.0f,
+		(int)( sum / numFrames ), samples[0], samples[ numFrames / 2 ],
+		samples[ numFrames * 99 / 100 ], samples[ numFrames - 1 ], frags );
+}
+
+
+/*
+================
+Bench_BuildEntityString
+
+Spawn points, items, a few timer chains and locations
+================
+*/
+static void Bench_BuildEntityString( void ) {
+	static const char *items[] = {
+		"weapon_shotgun", "weapon_rocketlauncher", "weapon_railgun",
+		"weapon_plasmagun", "weapon_lightning", "weapon_grenadelauncher",
+		"item_armor_body", "item_health_large", "item_quad"
+	};
+	char	*s;
+	int		i, x, y;
+
+	s = entityString;
+	s += sprintf( s, "{\n\"classname\" \"worldspawn\"\n\"message\" \"qabench\"\n}\n" );
+
+	// 32 spawn points on a grid
+	for ( i = 0; i < 32; i++ ) {
+		x = -1750 + ( i % 8 ) * 500;
+		y = -1500 + ( i / 8 ) * 1000;
+		s += sprintf( s, "{\n\"classname\" \"info_player_deathmatch\"\n\"origin\" \"%i %i 32\"\n\"angle\" \"%i\"\n}\n",
+			x, y, ( i * 45 ) % 360 );
+	}
+
+	// items in between
+	for ( i = 0; i < 36; i++ ) {
+		x = -1500 + ( i % 6 ) * 600;
+		y = -1500 + ( i / 6 ) * 600;
+		s += sprintf( s, "{\n\"classname\" \"%s\"\n\"origin\" \"%i %i 16\"\n}\n",
+			items[ i % ( sizeof( items ) / sizeof( items[0] ) ) ], x, y );
+	}
+
+	// think-driven entities
+	for ( i = 0; i < 8; i++ ) {
+		s += sprintf( s, "{\n\"classname\" \"func_timer\"\n\"spawnflags\" \"1\"\n\"wait\" \"%i\"\n\"random\" \"0.5\"\n\"target\" \"delay%i\"\n}\n",
+			1 + i % 3, i );
+		s += sprintf( s, "{\n\"classname\" \"target_delay\"\n\"targetname\" \"delay%i\"\n\"wait\" \"0.5\"\n}\n", i );
+	}
+
+	for ( i = 0; i < 16; i++ ) {
+		x = -1536 + ( i % 4 ) * 1024;
+		y = -1536 + ( i / 4 ) * 1024;
+		s += sprintf( s, "{\n\"classname\" \"target_location\"\n\"origin\" \"%i %i 64\"\n\"message\" \"area %i\"\n}\n", x, y, i );
+	}
+}
+
+
+/*
+================
+Bench_PlayerCmd
+
+Runs around and shoots at the next player in line
+================
+*/
+static void Bench_PlayerCmd( int clientNum, int numPlayers ) {
+	static const int weapons[] = {
+		WP_MACHINEGUN, WP_SHOTGUN, WP_ROCKET_LAUNCHER, WP_RAILGUN,
+		WP_PLASMAGUN, WP_LIGHTNING, WP_GRENADE_LAUNCHER
+	};
+	benchPlayer_t	*pl;
+	playerState_t	*ps, *target;
+	usercmd_t		*cmd;
+	vec3_t			dir, angles;
+	int				i;
+
+	pl = &players[ clientNum ];
+	ps = Bench_PlayerState( clientNum );
+	target = Bench_PlayerState( ( clientNum + 1 ) % numPlayers );
+	cmd = &benchCmds[ clientNum ];
+
+	if ( benchTime >= pl->nextChange ) {
+		pl->nextChange = benchTime + 250 + Bench_Rand( &pl->seed ) % 750;
+		pl->forwardmove = (int)( Bench_Rand( &pl->seed ) % 3 ) * 127 - 127;
+		pl->rightmove = (int)( Bench_Rand( &pl->seed ) % 3 ) * 127 - 127;
+		pl->jump = ( Bench_Rand( &pl->seed ) % 8 ) == 0;
+		pl->attack = ( Bench_Rand( &pl->seed ) % 5 ) < 3;
+		pl->weapon = weapons[ Bench_Rand( &pl->seed ) % ( sizeof( weapons ) / sizeof( weapons[0] ) ) ];
+		pl->aimError = (float)( (int)( Bench_Rand( &pl->seed ) % 21 ) - 10 );
+	}
+
+	memset( cmd, 0, sizeof( *cmd ) );
+	cmd->serverTime = benchTime;
+	cmd->forwardmove = pl->forwardmove;
+	cmd->rightmove = pl->rightmove;
+	cmd->upmove = pl->jump ? 127 : 0;
+	cmd->weapon = pl->weapon;
+	if ( pl->attack ) {
+		cmd->buttons |= BUTTON_ATTACK;
+	}
+
+	VectorSubtract( target->origin, ps->origin, dir );
+	dir[2] += target->viewheight - ps->viewheight;
+	vectoangles( dir, angles );
+	angles[YAW] += pl->aimError;
+	for ( i = 0; i < 3; i++ ) {
+		// the engine only sends 16 bits
+		cmd->angles[i] = ( ANGLE2SHORT( angles[i] ) - ps->delta_angles[i] ) & 65535;
+	}
+}
+
+
+/*
+================
+Bench_Run
+
+Returns qfalse if a client couldn't connect
+================
+*/
+static qboolean Bench_Run( int numPlayers, int numFrames, int fps, int seed ) {
+	char		userinfo[ MAX_INFO_STRING ];
+	const char	*reason;
+	int			*samples;
+	int			i, frame, msec, start, frags;
+
+	Bench_ResetServer( entityString );
+
+	Bench_SetCvar( "//trap_GetValue", va( "%i", BENCH_GET_VALUE ) );
+	Bench_SetCvar( "sv_maxclients", va( "%i", numPlayers ) );
+	Bench_SetCvar( "sv_fps", va( "%i", fps ) );
+	Bench_SetCvar( "mapname", "qabench" );
+	Bench_SetCvar( "dedicated", "1" );
+	Bench_SetCvar( "g_gametype", "0" );
+	Bench_SetCvar( "fraglimit", "0" );
+	Bench_SetCvar( "timelimit", "0" );
+	Bench_SetCvar( "g_warmup", "0" );
+	Bench_SetCvar( "g_log", "" );
+	Bench_SetCvar( "bot_enable", "0" );
+	Bench_SetCvar( "g_profile", "1" );
+	Bench_ApplyOverrides();
+
+	msec = 1000 / fps;
+	benchTime = 0;
+
+	vmMain( GAME_INIT, benchTime, seed, qfalse );
+
+	// let the world settle like the server does after a map load
+	for ( i = 0; i < 3; i++ ) {
+		benchTime += 100;
+		vmMain( GAME_RUN_FRAME, benchTime, 0, 0 );
+	}
+
+	for ( i = 0; i < numPlayers; i++ ) {
+		Com_sprintf( userinfo, sizeof( userinfo ),
+			"\\name\\bench%i\\model\\sarge\\headmodel\\sarge\\handicap\\100\\color1\\4\\color2\\5\\rate\\25000\\snaps\\40\\ip\\10.0.%i.%i",
+			i, i / 250, i % 250 + 1 );
+		Bench_SetUserinfo( i, userinfo );
+
+		reason = (const char *)vmMain( GAME_CLIENT_CONNECT, i, qtrue, qfalse );
+		if ( reason ) {
+			fprintf( stderr, "client %i refused: %s\n", i, reason );
+			return qfalse;
+		}
+		vmMain( GAME_CLIENT_BEGIN, i, 0, 0 );
+
+		memset( &players[i], 0, sizeof( players[i] ) );
+		players[i].seed = seed * 7919 + i;
+	}
+
+	samples = malloc( numFrames * sizeof( *samples ) );
+
+	for ( frame = 0; frame < numFrames; frame++ ) {
+		benchTime += msec;
+
+		start = Bench_Microseconds();
+		for ( i = 0; i < numPlayers; i++ ) {
+			Bench_PlayerCmd( i, numPlayers );
+			vmMain( GAME_CLIENT_THINK, i, 0, 0 );
+		}
+		vmMain( GAME_RUN_FRAME, benchTime, 0, 0 );
+		samples[ frame ] = (unsigned int)Bench_Microseconds() - (unsigned int)start;
+	}
+
+	if ( benchVerbose ) {
+		Bench_SetCommand( "profile" );
+		vmMain( GAME_CONSOLE_COMMAND, 0, 0, 0 );
+		Bench_SetCommand( "g_entityStats" );
+		vmMain( GAME_CONSOLE_COMMAND, 0, 0, 0 );
+		Bench_SetCommand( "game_memory" );
+		vmMain( GAME_CONSOLE_COMMAND, 0, 0, 0 );
+	}
+
+	frags = 0;
+	for ( i = 0; i < numPlayers; i++ ) {
+		frags += Bench_PlayerState( i )->persistant[ PERS_SCORE ];
+	}
+
+	for ( i = 0; i < numPlayers; i++ ) {
+		vmMain( GAME_CLIENT_DISCONNECT, i, 0, 0 );
+	}
+	vmMain( GAME_SHUTDOWN, qfalse, 0, 0 );
+
+	Bench_PrintResult( numPlayers, samples, numFrames, frags );
+
+	free( samples );
+	return qtrue;
+}
+
+
+int main( int argc, char **argv ) {
+	int			runs[ MAX_RUNS ];
+	int			numRuns, numFrames, fps, seed;
+	const char	*replay;
+	qboolean	pmove;
+	int			i;
+
+	numRuns = 0;
+	numFrames = 2000;
+	fps = 40;
+	seed = 1;
+	replay = NULL;
+	pmove = qfalse;
+
+	for ( i = 1; i < argc; i++ ) {
+		if ( !strcmp( argv[i], "-players" ) && i + 1 < argc && numRuns < MAX_RUNS ) {
+			runs[ numRuns++ ] = atoi( argv[++i] );
+		} else if ( !strcmp( argv[i], "-frames" ) && i + 1 < argc ) {
+			numFrames = atoi( argv[++i] );
+		} else if ( !strcmp( argv[i], "-fps" ) && i + 1 < argc ) {
+			fps = atoi( argv[++i] );
+		} else if ( !strcmp( argv[i], "-seed" ) && i + 1 < argc ) {
+			seed = atoi( argv[++i] );
+		} else if ( !strcmp( argv[i], "-replay" ) && i + 1 < argc ) {
+			replay = argv[++i];
+		} else if ( !strcmp( argv[i], "+set" ) && i + 2 < argc && numOverrides < MAX_OVERRIDES ) {
+			overrides[ numOverrides ][0] = argv[++i];
+			overrides[ numOverrides++ ][1] = argv[++i];
+		} else if ( !strcmp( argv[i], "-pmove" ) ) {
+			pmove = qtrue;
+		} else if ( !strcmp( argv[i], "-v" ) ) {
+			benchVerbose = qtrue;
+		} else {
+			fprintf( stderr, "usage: %s [-players <n>] [-frames <n>] [-fps <n>] [-seed <n>] [-replay <file>] [-pmove] [-v] [+set <cvar> <value>]\n", argv[0] );
+			return 1;
+		}
+	}
+
+	if ( !numRuns ) {
+		runs[ numRuns++ ] = 8;
+		runs[ numRuns++ ] = 32;
+		runs[ numRuns++ ] = 64;
+	}
+
+	for ( i = 0; i < numRuns; i++ ) {
+		if ( runs[i] < 1 || runs[i] > MAX_CLIENTS ) {
+			fprintf( stderr, "players must be 1..%i\n", MAX_CLIENTS );
+			return 1;
+		}
+	}
+	if ( numFrames < 1 || fps < 1 || fps > 1000 ) {
+		fprintf( stderr, "bad -frames or -fps\n" );
+		return 1;
+	}
+
+	dllEntry( Bench_Syscall );
+
+	if ( pmove ) {
+		Bench_PmoveHeader();
+		if ( replay ) {
+			return Bench_Pmove( MAX_CLIENTS, 0, seed, replay ) ? 0 : 1;
+		}
+		for ( i = 0; i < numRuns; i++ ) {
+			Bench_Pmove( runs[i], numFrames, seed, NULL );
+		}
+		return 0;
+	}
+
+	if ( replay ) {
+		return Bench_Replay( replay ) ? 0 : 1;
+	}
+
+	Bench_BuildEntityString();
+
+	printf( "sv_fps %i, seed %i, frame times in usec\n", fps, seed );
+	Bench_PrintHeader();
+
+	for ( i = 0; i < numRuns; i++ ) {
+		if ( !Bench_Run( runs[i], numFrames, fps, seed ) ) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,222 @@
+// Public Domain
+//
+// bench_pmove.c -- player movement throughput
+//
+// Runs the shared bg_pmove.c/bg_slidemove.c code on its own, the same code
+// ClientThink_real and CG_PredictPlayerState run, against the bench box
+// room.  The commands are either generated (running, strafing, jumping,
+// crouching and turning at a 125 fps client rate) or taken from a
+// g_recordCmds recording with -replay.  Every frame runs one command
+// through Pmove for each player in turn, the way the server does.
+//
+
+#include "bench_local.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PMOVE_CMD_MSEC		8
+
+extern int c_pmove;
+
+static playerState_t	pmoveStates[ MAX_CLIENTS ];
+static pmove_t			pmoves[ MAX_CLIENTS ];
+static benchCmdStream_t	pmoveStreams[ MAX_CLIENTS ];
+
+static int	pmoveTraces;
+static int	pmoveContents;
+
+
+static void Pmove_Trace( trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentMask ) {
+	pmoveTraces++;
+	Bench_Trace( results, start, mins, maxs, end, passEntityNum, contentMask );
+}
+
+
+static int Pmove_PointContents( const vec3_t point, int passEntityNum ) {
+	pmoveContents++;
+	return Bench_PointContents( point, passEntityNum );
+}
+
+
+static unsigned int Pmove_Rand( unsigned int *seed ) {
+	*seed = *seed * 1103515245u + 12345u;
+	return ( *seed >> 16 ) & 0x7fff;
+}
+
+
+/*
+================
+Pmove_GenerateCmds
+================
+*/
+static void Pmove_GenerateCmds( benchCmdStream_t *st, int numCmds, unsigned int seed ) {
+	usercmd_t	cmd;
+	int			i, nextChange, yawSpeed;
+
+	st->cmds = malloc( numCmds * sizeof( st->cmds[0] ) );
+	st->numCmds = st->maxCmds = numCmds;
+
+	memset( &cmd, 0, sizeof( cmd ) );
+	cmd.weapon = WP_MACHINEGUN;
+	nextChange = 0;
+	yawSpeed = 0;
+
+	for ( i = 0; i < numCmds; i++ ) {
+		cmd.serverTime = ( i + 1 ) * PMOVE_CMD_MSEC;
+
+		if ( cmd.serverTime >= nextChange ) {
+			nextChange = cmd.serverTime + 250 + Pmove_Rand( &seed ) % 750;
+			cmd.forwardmove = (int)( Pmove_Rand( &seed ) % 3 ) * 127 - 127;
+			cmd.rightmove = (int)( Pmove_Rand( &seed ) % 3 ) * 127 - 127;
+			switch ( Pmove_Rand( &seed ) % 8 ) {
+			case 0:
+				cmd.upmove = 127;
+				break;
+			case 1:
+				cmd.upmove = -127;
+				break;
+			default:
+				cmd.upmove = 0;
+				break;
+			}
+			yawSpeed = (int)( Pmove_Rand( &seed ) % 401 ) - 200;
+		}
+
+		cmd.angles[YAW] = ( cmd.angles[YAW] + yawSpeed ) & 65535;
+		st->cmds[i] = cmd;
+	}
+}
+
+
+/*
+================
+Pmove_Setup
+
+Puts everybody on the floor at their spawn spot
+================
+*/
+static void Pmove_Setup( int numPlayers ) {
+	playerState_t	*ps;
+	pmove_t			*pm;
+	int				i;
+
+	for ( i = 0; i < numPlayers; i++ ) {
+		ps = &pmoveStates[i];
+		memset( ps, 0, sizeof( *ps ) );
+		ps->clientNum = i;
+		ps->pm_type = PM_NORMAL;
+		ps->gravity = DEFAULT_GRAVITY;
+		ps->speed = 320;
+		ps->stats[STAT_HEALTH] = 100;
+		ps->stats[STAT_WEAPONS] = 1 << WP_MACHINEGUN;
+		ps->ammo[WP_MACHINEGUN] = 100;
+		ps->weapon = WP_MACHINEGUN;
+		ps->weaponstate = WEAPON_READY;
+		ps->viewheight = DEFAULT_VIEWHEIGHT;
+		ps->origin[0] = -1750 + ( i % 8 ) * 500;
+		ps->origin[1] = -1750 + ( ( i / 8 ) % 8 ) * 500;
+		ps->origin[2] = -MINS_Z + 1;
+		ps->commandTime = pmoveStreams[i].cmds[0].serverTime - PMOVE_CMD_MSEC;
+
+		pm = &pmoves[i];
+		memset( pm, 0, sizeof( *pm ) );
+		pm->ps = ps;
+		pm->tracemask = MASK_PLAYERSOLID;
+		pm->trace = Pmove_Trace;
+		pm->pointcontents = Pmove_PointContents;
+	}
+}
+
+
+/*
+================
+Pmove_Pass
+
+Returns the time taken in usec
+================
+*/
+static int Pmove_Pass( int numPlayers, int numCmds ) {
+	int i, j, start;
+
+	Pmove_Setup( numPlayers );
+	pmoveTraces = pmoveContents = c_pmove = 0;
+
+	start = Bench_Microseconds();
+	for ( j = 0; j < numCmds; j++ ) {
+		for ( i = 0; i < numPlayers; i++ ) {
+			pmoves[i].cmd = pmoveStreams[i].cmds[ j < pmoveStreams[i].numCmds ? j : pmoveStreams[i].numCmds - 1 ];
+			Pmove( &pmoves[i] );
+		}
+	}
+
+	return (unsigned int)Bench_Microseconds() - (unsigned int)start;
+}
+
+
+static void Pmove_Print( const char *name, int numPlayers, int totalCmds, int usec ) {
+	float total;
+
+	total = totalCmds;
+	printf( "%-10s %7i %9i %8i %11.0f %8.2f %8.2f %8.2f\n", name, numPlayers, (int)total,
+		usec / 1000, usec ? total * 1000000.0f / usec : 0.0f,
+		pmoveTraces / total, pmoveContents / total, c_pmove / total );
+}
+
+
+/*
+================
+Bench_Pmove
+
+With a recording numPlayers and numCmds are limited to what it contains
+================
+*/
+qboolean Bench_Pmove( int numPlayers, int numCmds, int seed, const char *replay ) {
+	int i, usec, numStreams, totalCmds;
+
+	Bench_ResetServer( NULL );
+
+	if ( replay ) {
+		numStreams = Bench_LoadUsercmds( replay, pmoveStreams );
+		if ( !numStreams ) {
+			fprintf( stderr, "no usercmds in %s\n", replay );
+			return qfalse;
+		}
+		if ( numPlayers > numStreams ) {
+			numPlayers = numStreams;
+		}
+		// shorter streams repeat their last command, which doesn't move
+		for ( i = 0, numCmds = 0; i < numPlayers; i++ ) {
+			if ( pmoveStreams[i].numCmds > numCmds ) {
+				numCmds = pmoveStreams[i].numCmds;
+			}
+		}
+	} else {
+		for ( i = 0; i < numPlayers; i++ ) {
+			Pmove_GenerateCmds( &pmoveStreams[i], numCmds, seed * 7919 + i );
+		}
+		numStreams = numPlayers;
+	}
+
+	totalCmds = 0;
+	for ( i = 0; i < numPlayers; i++ ) {
+		totalCmds += pmoveStreams[i].numCmds < numCmds ? pmoveStreams[i].numCmds : numCmds;
+	}
+
+	usec = Pmove_Pass( numPlayers, numCmds );
+	Pmove_Print( "Pmove", numPlayers, totalCmds, usec );
+
+	for ( i = 0; i < numStreams; i++ ) {
+		free( pmoveStreams[i].cmds );
+	}
+	memset( pmoveStreams, 0, sizeof( pmoveStreams ) );
+
+	return qtrue;
+}
+
+
+void Bench_PmoveHeader( void ) {
+	printf( "player movement, generated commands are %i msec apart, per command figures\n", PMOVE_CMD_MSEC );
+	printf( "%-10s %7s %9s %8s %11s %8s %8s %8s\n",
+		"driver", "players", "cmds", "msec", "cmds/sec", "traces", "contents", "moves" );
+}
@@ -0,0 +1,546 @@
+// Public Domain
+//
+// bench_replay.c -- plays back a g_recordCmds recording
+//
+// The events are fed to the game module in the order they were recorded,
+// with the recorded random seed and serverinfo, so the game sees the same
+// inputs and cvars as on the live server.  The world is still the bench box room,
+// the map entities are spawned but there is no map geometry, so player
+// movement only follows the live match as long as nobody touches a wall.
+// Bots are replayed as regular clients from their recorded usercmds.
+//
+
+#include "bench_local.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+	const byte	*data;
+	int			size;
+	int			pos;
+	qboolean	overflow;
+} replayMsg_t;
+
+// one decoded event
+typedef struct {
+	int			type;
+	int			clientNum;
+	int			levelTime;			// REC_FRAME
+	int			firstTime;			// REC_CONNECT
+	char		info[ MAX_INFO_STRING ];	// REC_CONNECT, REC_USERINFO
+	int			argc;				// REC_COMMAND
+	char		args[ MAX_STRING_TOKENS ][ MAX_TOKEN_CHARS ];
+	char		*argv[ MAX_STRING_TOKENS ];
+} replayRecord_t;
+
+static char				replayEntities[ 0x40000 ];
+static usercmd_t		replayCmds[ MAX_CLIENTS ];
+static qboolean			replayConnected[ MAX_CLIENTS ];
+static replayRecord_t	replayRecord;
+
+
+static int Replay_Byte( replayMsg_t *msg ) {
+	if ( msg->pos + 1 > msg->size ) {
+		msg->overflow = qtrue;
+		return 0;
+	}
+	return msg->data[ msg->pos++ ];
+}
+
+
+static int Replay_Short( replayMsg_t *msg ) {
+	int v;
+
+	v = Replay_Byte( msg );
+	v |= Replay_Byte( msg ) << 8;
+	return v;
+}
+
+
+static int Replay_Int( replayMsg_t *msg ) {
+	unsigned int v;
+
+	v = Replay_Byte( msg );
+	v |= Replay_Byte( msg ) << 8;
+	v |= Replay_Byte( msg ) << 16;
+	v |= (unsigned int)Replay_Byte( msg ) << 24;
+	return (int)v;
+}
+
+
+static void Replay_String( replayMsg_t *msg, char *buffer, int bufferSize ) {
+	int len;
+
+	len = Replay_Short( msg );
+	if ( msg->pos + len > msg->size ) {
+		msg->overflow = qtrue;
+		len = 0;
+	}
+
+	if ( len >= bufferSize ) {
+		memcpy( buffer, msg->data + msg->pos, bufferSize - 1 );
+		buffer[ bufferSize - 1 ] = '\0';
+	} else {
+		memcpy( buffer, msg->data + msg->pos, len );
+		buffer[ len ] = '\0';
+	}
+	msg->pos += len;
+}
+
+
+static int Replay_Client( replayMsg_t *msg ) {
+	int clientNum;
+
+	clientNum = Replay_Byte( msg );
+	if ( clientNum >= MAX_CLIENTS ) {
+		msg->overflow = qtrue;
+		return 0;
+	}
+	return clientNum;
+}
+
+
+/*
+================
+Replay_ReadUsercmd
+================
+*/
+static void Replay_ReadUsercmd( replayMsg_t *msg, usercmd_t *cmd ) {
+	int mask;
+
+	mask = Replay_Byte( msg );
+	cmd->serverTime = Replay_Int( msg );
+	if ( mask & UCMD_PITCH )
+		cmd->angles[0] = Replay_Short( msg );
+	if ( mask & UCMD_YAW )
+		cmd->angles[1] = Replay_Short( msg );
+	if ( mask & UCMD_ROLL )
+		cmd->angles[2] = Replay_Short( msg );
+	if ( mask & UCMD_BUTTONS )
+		cmd->buttons = Replay_Int( msg );
+	if ( mask & UCMD_WEAPON )
+		cmd->weapon = Replay_Byte( msg );
+	if ( mask & UCMD_MOVE ) {
+		cmd->forwardmove = (signed char)Replay_Byte( msg );
+		cmd->rightmove = (signed char)Replay_Byte( msg );
+		cmd->upmove = (signed char)Replay_Byte( msg );
+	}
+}
+
+
+/*
+================
+Replay_ReadSetup
+
+Sets the REC_CVAR records at the start of the recording and turns the
+REC_SPAWN records that follow back into an entity string
+================
+*/
+static void Replay_ReadSetup( replayMsg_t *msg ) {
+	char	key[ MAX_TOKEN_CHARS ], value[ MAX_TOKEN_CHARS ];
+	char	*s, *end;
+	int		i, numPairs;
+
+	s = replayEntities;
+	end = replayEntities + sizeof( replayEntities );
+	*s = '\0';
+
+	while ( msg->pos < msg->size && msg->data[ msg->pos ] == REC_CVAR ) {
+		msg->pos++;
+		Replay_String( msg, key, sizeof( key ) );
+		Replay_String( msg, value, sizeof( value ) );
+		Bench_SetCvar( key, value );
+	}
+
+	while ( msg->pos < msg->size && msg->data[ msg->pos ] == REC_SPAWN ) {
+		msg->pos++;
+		numPairs = Replay_Byte( msg );
+		s += Com_sprintf( s, end - s, "{\n" );
+		for ( i = 0; i < numPairs; i++ ) {
+			Replay_String( msg, key, sizeof( key ) );
+			Replay_String( msg, value, sizeof( value ) );
+			s += Com_sprintf( s, end - s, "\"%s\" \"%s\"\n", key, value );
+		}
+		s += Com_sprintf( s, end - s, "}\n" );
+	}
+}
+
+
+/*
+================
+Replay_SetServerinfo
+================
+*/
+static void Replay_SetServerinfo( const char *info ) {
+	char	key[ BIG_INFO_KEY ], value[ BIG_INFO_VALUE ];
+
+	while ( 1 ) {
+		info = Info_NextPair( info, key, value );
+		if ( !key[0] ) {
+			break;
+		}
+		Bench_SetCvar( key, value );
+	}
+}
+
+
+/*
+================
+Replay_ReadRecord
+
+Decodes the next event, usercmds are applied to replayCmds.
+Returns REC_END at the end of the recording or when it is damaged.
+================
+*/
+static int Replay_ReadRecord( replayMsg_t *msg, replayRecord_t *rec ) {
+	char	skip[ MAX_TOKEN_CHARS ];
+	int		i;
+
+	rec->type = Replay_Byte( msg );
+	if ( msg->overflow ) {
+		return REC_END;
+	}
+
+	switch ( rec->type ) {
+	case REC_END:
+		break;
+	case REC_FRAME:
+		rec->levelTime = Replay_Int( msg );
+		break;
+	case REC_CONNECT:
+		rec->clientNum = Replay_Client( msg );
+		rec->firstTime = Replay_Byte( msg );
+		Replay_Byte( msg );		// isBot, bots connect as regular clients
+		Replay_String( msg, rec->info, sizeof( rec->info ) );
+		memset( &replayCmds[ rec->clientNum ], 0, sizeof( replayCmds[0] ) );
+		break;
+	case REC_BEGIN:
+	case REC_DISCONNECT:
+		rec->clientNum = Replay_Client( msg );
+		break;
+	case REC_USERINFO:
+		rec->clientNum = Replay_Client( msg );
+		Replay_String( msg, rec->info, sizeof( rec->info ) );
+		break;
+	case REC_COMMAND:
+		rec->clientNum = Replay_Client( msg );
+		rec->argc = Replay_Byte( msg );
+		for ( i = 0; i < rec->argc; i++ ) {
+			rec->argv[i] = rec->args[i];
+			Replay_String( msg, i < MAX_STRING_TOKENS ? rec->args[i] : skip, MAX_TOKEN_CHARS );
+		}
+		if ( rec->argc > MAX_STRING_TOKENS ) {
+			rec->argc = MAX_STRING_TOKENS;
+		}
+		break;
+	case REC_USERCMD:
+		rec->clientNum = Replay_Client( msg );
+		Replay_ReadUsercmd( msg, &replayCmds[ rec->clientNum ] );
+		break;
+	default:
+		fprintf( stderr, "bad record type %i at offset %i\n", rec->type, msg->pos - 1 );
+		msg->overflow = qtrue;
+		break;
+	}
+
+	if ( msg->overflow ) {
+		printf( "recording is truncated, stopped at offset %i\n", msg->pos );
+		rec->type = REC_END;
+	}
+
+	return rec->type;
+}
+
+
+/*
+================
+Replay_ReadHeader
+
+Reads everything up to the first event, the entities end up in replayEntities
+================
+*/
+static qboolean Replay_ReadHeader( replayMsg_t *msg, int *levelTime, int *seed, int *fps, char *info, int infoSize ) {
+	if ( Replay_Int( msg ) != RECORD_MAGIC || Replay_Int( msg ) != RECORD_VERSION ) {
+		fprintf( stderr, "not a version %i usercmd recording\n", RECORD_VERSION );
+		return qfalse;
+	}
+
+	*levelTime = Replay_Int( msg );
+	*seed = Replay_Int( msg );
+	*fps = Replay_Int( msg );
+	Replay_String( msg, info, infoSize );
+
+	Bench_ResetServer( NULL );
+	Replay_SetServerinfo( info );
+
+	Replay_ReadSetup( msg );
+	if ( msg->overflow ) {
+		fprintf( stderr, "truncated recording\n" );
+		return qfalse;
+	}
+
+	memset( replayCmds, 0, sizeof( replayCmds ) );
+	return qtrue;
+}
+
+
+/*
+================
+Replay_Frags
+
+Scores of the clients still connected plus the ones that already left
+================
+*/
+static int Replay_Frags( int frags ) {
+	int i;
+
+	for ( i = 0; i < MAX_CLIENTS; i++ ) {
+		if ( replayConnected[i] ) {
+			frags += Bench_PlayerState( i )->persistant[ PERS_SCORE ];
+		}
+	}
+	return frags;
+}
+
+
+/*
+================
+Replay_Run
+
+Returns qfalse if the recording is damaged
+================
+*/
+static qboolean Replay_Run( replayMsg_t *msg ) {
+	replayRecord_t	*rec;
+	char			info[ MAX_INFO_STRING ];
+	const char		*reason;
+	int				*samples;
+	int				numSamples, maxSamples;
+	int				levelTime, seed, fps;
+	int				i, start, players, maxPlayers, frags;
+
+	if ( !Replay_ReadHeader( msg, &levelTime, &seed, &fps, info, sizeof( info ) ) ) {
+		return qfalse;
+	}
+	Bench_SetEntityString( replayEntities );
+
+	Bench_SetCvar( "//trap_GetValue", va( "%i", BENCH_GET_VALUE ) );
+	Bench_SetCvar( "sv_fps", va( "%i", fps ) );
+	Bench_SetCvar( "dedicated", "1" );
+	Bench_SetCvar( "g_log", "" );
+	Bench_SetCvar( "bot_enable", "0" );
+	Bench_SetCvar( "g_recordCmds", "0" );
+	Bench_SetCvar( "g_profile", "1" );
+	Bench_ApplyOverrides();
+
+	printf( "%s, sv_fps %i, seed %i, frame times in usec\n", Info_ValueForKey( info, "mapname" ), fps, seed );
+	Bench_PrintHeader();
+
+	memset( replayConnected, 0, sizeof( replayConnected ) );
+	players = maxPlayers = 0;
+	frags = 0;
+
+	benchTime = levelTime;
+	vmMain( GAME_INIT, levelTime, seed, qfalse );
+
+	maxSamples = 1024;
+	numSamples = 0;
+	samples = malloc( maxSamples * sizeof( *samples ) );
+
+	rec = &replayRecord;
+	start = Bench_Microseconds();
+	while ( Replay_ReadRecord( msg, rec ) != REC_END ) {
+		switch ( rec->type ) {
+		case REC_FRAME:
+			benchTime = rec->levelTime;
+			vmMain( GAME_RUN_FRAME, benchTime, 0, 0 );
+
+			// client events since the previous frame count towards this one
+			if ( numSamples == maxSamples ) {
+				maxSamples *= 2;
+				samples = realloc( samples, maxSamples * sizeof( *samples ) );
+			}
+			samples[ numSamples++ ] = (unsigned int)Bench_Microseconds() - (unsigned int)start;
+			start = Bench_Microseconds();
+			break;
+
+		case REC_CONNECT:
+			Bench_SetUserinfo( rec->clientNum, rec->info );
+			reason = (const char *)vmMain( GAME_CLIENT_CONNECT, rec->clientNum, rec->firstTime, qfalse );
+			if ( reason ) {
+				if ( benchVerbose ) {
+					printf( "client %i refused: %s\n", rec->clientNum, reason );
+				}
+				break;
+			}
+			if ( !replayConnected[ rec->clientNum ] ) {
+				replayConnected[ rec->clientNum ] = qtrue;
+				if ( ++players > maxPlayers ) {
+					maxPlayers = players;
+				}
+			}
+			break;
+
+		case REC_BEGIN:
+			if ( replayConnected[ rec->clientNum ] ) {
+				vmMain( GAME_CLIENT_BEGIN, rec->clientNum, 0, 0 );
+			}
+			break;
+
+		case REC_USERINFO:
+			Bench_SetUserinfo( rec->clientNum, rec->info );
+			if ( replayConnected[ rec->clientNum ] ) {
+				vmMain( GAME_CLIENT_USERINFO_CHANGED, rec->clientNum, 0, 0 );
+			}
+			break;
+
+		case REC_DISCONNECT:
+			if ( replayConnected[ rec->clientNum ] ) {
+				frags += Bench_PlayerState( rec->clientNum )->persistant[ PERS_SCORE ];
+				vmMain( GAME_CLIENT_DISCONNECT, rec->clientNum, 0, 0 );
+				replayConnected[ rec->clientNum ] = qfalse;
+				players--;
+			}
+			break;
+
+		case REC_COMMAND:
+			if ( replayConnected[ rec->clientNum ] ) {
+				Bench_SetArgs( rec->argc, rec->argv );
+				vmMain( GAME_CLIENT_COMMAND, rec->clientNum, 0, 0 );
+			}
+			break;
+
+		case REC_USERCMD:
+			if ( replayConnected[ rec->clientNum ] ) {
+				benchCmds[ rec->clientNum ] = replayCmds[ rec->clientNum ];
+				vmMain( GAME_CLIENT_THINK, rec->clientNum, 0, 0 );
+			}
+			break;
+		}
+	}
+
+	if ( benchVerbose ) {
+		Bench_SetCommand( "profile" );
+		vmMain( GAME_CONSOLE_COMMAND, 0, 0, 0 );
+	}
+
+	Bench_PrintResult( maxPlayers, samples, numSamples, Replay_Frags( frags ) );
+	free( samples );
+
+	for ( i = 0; i < MAX_CLIENTS; i++ ) {
+		if ( replayConnected[i] ) {
+			vmMain( GAME_CLIENT_DISCONNECT, i, 0, 0 );
+		}
+	}
+	vmMain( GAME_SHUTDOWN, qfalse, 0, 0 );
+
+	return qtrue;
+}
+
+
+/*
+================
+Replay_Load
+================
+*/
+static qboolean Replay_Load( const char *filename, replayMsg_t *msg ) {
+	FILE	*f;
+	byte	*data;
+	long	size;
+
+	f = fopen( filename, "rb" );
+	if ( !f ) {
+		fprintf( stderr, "couldn't open %s\n", filename );
+		return qfalse;
+	}
+
+	fseek( f, 0, SEEK_END );
+	size = ftell( f );
+	fseek( f, 0, SEEK_SET );
+
+	data = malloc( size > 0 ? size : 1 );
+	if ( fread( data, 1, size, f ) != (size_t)size ) {
+		fprintf( stderr, "couldn't read %s\n", filename );
+		fclose( f );
+		free( data );
+		return qfalse;
+	}
+	fclose( f );
+
+	memset( msg, 0, sizeof( *msg ) );
+	msg->data = data;
+	msg->size = size;
+	return qtrue;
+}
+
+
+/*
+================
+Bench_Replay
+================
+*/
+qboolean Bench_Replay( const char *filename ) {
+	replayMsg_t	msg;
+	qboolean	ok;
+
+	if ( !Replay_Load( filename, &msg ) ) {
+		return qfalse;
+	}
+
+	ok = Replay_Run( &msg );
+
+	free( (void *)msg.data );
+	return ok;
+}
+
+
+/*
+================
+Bench_LoadUsercmds
+
+Collects the usercmds of every client in the recording, for the pmove
+benchmark.  Returns the number of clients with at least one usercmd.
+================
+*/
+int Bench_LoadUsercmds( const char *filename, benchCmdStream_t *streams ) {
+	replayMsg_t			msg;
+	benchCmdStream_t	*st;
+	char				info[ MAX_INFO_STRING ];
+	int					levelTime, seed, fps;
+	int					i, numStreams;
+
+	memset( streams, 0, MAX_CLIENTS * sizeof( streams[0] ) );
+
+	if ( !Replay_Load( filename, &msg ) ) {
+		return 0;
+	}
+
+	if ( Replay_ReadHeader( &msg, &levelTime, &seed, &fps, info, sizeof( info ) ) ) {
+		while ( Replay_ReadRecord( &msg, &replayRecord ) != REC_END ) {
+			if ( replayRecord.type != REC_USERCMD ) {
+				continue;
+			}
+			st = &streams[ replayRecord.clientNum ];
+			if ( st->numCmds == st->maxCmds ) {
+				st->maxCmds = st->maxCmds ? st->maxCmds * 2 : 1024;
+				st->cmds = realloc( st->cmds, st->maxCmds * sizeof( st->cmds[0] ) );
+			}
+			st->cmds[ st->numCmds++ ] = replayCmds[ replayRecord.clientNum ];
+		}
+	}
+
+	free( (void *)msg.data );
+
+	numStreams = 0;
+	for ( i = 0; i < MAX_CLIENTS; i++ ) {
+		if ( streams[i].numCmds ) {
+			streams[ numStreams++ ] = streams[i];
+		}
+	}
+	for ( i = numStreams; i < MAX_CLIENTS; i++ ) {
+		memset( &streams[i], 0, sizeof( streams[i] ) );
+	}
+
+	return numStreams;
+}
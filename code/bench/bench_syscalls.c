@@ -0,0 +1,815 @@
+// Public Domain
+//
+// bench_syscalls.c -- just enough of a server for the game module to run
+//
+// The game module is linked in together with its regular g_syscalls.c and
+// gets Bench_Syscall through dllEntry, the same way a real engine hands it
+// its syscall dispatcher.  Collision is done against an empty box room and
+// the bounding boxes of linked entities, nothing is loaded from disk.
+//
+
+#include "bench_local.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#define MAX_BENCH_CVARS		1024
+#define MAX_BENCH_FILES		16
+
+typedef struct {
+	char	name[ MAX_CVAR_VALUE_STRING ];
+	char	string[ MAX_CVAR_VALUE_STRING ];
+	int		flags;
+	int		modificationCount;
+} benchCvar_t;
+
+static benchCvar_t	cvars[ MAX_BENCH_CVARS ];
+static int			numCvars;
+
+static char		*configstrings[ MAX_CONFIGSTRINGS ];
+static char		userinfos[ MAX_CLIENTS ][ MAX_INFO_STRING ];
+
+static byte		*gentities;
+static int		numGEntities;
+static int		sizeofGEntity;
+static byte		*gameClients;
+static int		sizeofGameClient;
+
+static const char	*entityParse;
+static int			serverCommands;
+
+static FILE		*files[ MAX_BENCH_FILES ];
+
+static char		cmdArgv[ MAX_STRING_TOKENS ][ MAX_TOKEN_CHARS ];
+static int		cmdArgc;
+
+static const vec3_t	worldMins = { -BENCH_WORLD_SIZE, -BENCH_WORLD_SIZE, 0 };
+static const vec3_t	worldMaxs = { BENCH_WORLD_SIZE, BENCH_WORLD_SIZE, BENCH_WORLD_HEIGHT };
+
+int			benchTime;
+usercmd_t	benchCmds[ MAX_CLIENTS ];
+qboolean	benchVerbose;
+
+#define GENT( num ) ( (sharedEntity_t *)( gentities + sizeofGEntity * (num) ) )
+
+
+int Bench_Microseconds( void ) {
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (int)( (unsigned int)ts.tv_sec * 1000000u + (unsigned int)( ts.tv_nsec / 1000 ) );
+}
+
+
+int Bench_ServerCommands( void ) {
+	return serverCommands;
+}
+
+
+playerState_t *Bench_PlayerState( int clientNum ) {
+	return (playerState_t *)( gameClients + sizeofGameClient * clientNum );
+}
+
+
+/*
+==============================================================================
+
+cvars, configstrings, userinfo
+
+==============================================================================
+*/
+
+static benchCvar_t *Bench_FindCvar( const char *name, qboolean create ) {
+	int i;
+
+	for ( i = 0; i < numCvars; i++ ) {
+		if ( !Q_stricmp( cvars[i].name, name ) ) {
+			return &cvars[i];
+		}
+	}
+
+	if ( !create ) {
+		return NULL;
+	}
+	if ( numCvars == MAX_BENCH_CVARS ) {
+		fprintf( stderr, "too many cvars\n" );
+		exit( 1 );
+	}
+
+	Q_strncpyz( cvars[ numCvars ].name, name, sizeof( cvars[0].name ) );
+	return &cvars[ numCvars++ ];
+}
+
+
+void Bench_SetCvar( const char *name, const char *value ) {
+	benchCvar_t *cv;
+
+	cv = Bench_FindCvar( name, qtrue );
+	Q_strncpyz( cv->string, value, sizeof( cv->string ) );
+	cv->modificationCount++;
+}
+
+
+static void Bench_UpdateVmCvar( vmCvar_t *vmCvar ) {
+	benchCvar_t *cv;
+
+	if ( (unsigned)vmCvar->handle >= (unsigned)numCvars ) {
+		return;
+	}
+
+	cv = &cvars[ vmCvar->handle ];
+	vmCvar->modificationCount = cv->modificationCount;
+	vmCvar->value = atof( cv->string );
+	vmCvar->integer = atoi( cv->string );
+	Q_strncpyz( vmCvar->string, cv->string, sizeof( vmCvar->string ) );
+}
+
+
+static void Bench_RegisterCvar( vmCvar_t *vmCvar, const char *name, const char *defaultValue, int flags ) {
+	benchCvar_t *cv;
+
+	cv = Bench_FindCvar( name, qfalse );
+	if ( !cv ) {
+		cv = Bench_FindCvar( name, qtrue );
+		Q_strncpyz( cv->string, defaultValue, sizeof( cv->string ) );
+		cv->modificationCount = 1;
+	}
+	cv->flags |= flags;
+
+	if ( vmCvar ) {
+		vmCvar->handle = cv - cvars;
+		Bench_UpdateVmCvar( vmCvar );
+	}
+}
+
+
+static void Bench_SetConfigstring( int num, const char *string ) {
+	if ( (unsigned)num >= MAX_CONFIGSTRINGS ) {
+		fprintf( stderr, "Bench_SetConfigstring: bad index %i\n", num );
+		exit( 1 );
+	}
+
+	free( configstrings[ num ] );
+	configstrings[ num ] = NULL;
+	if ( string && string[0] ) {
+		configstrings[ num ] = strdup( string );
+	}
+}
+
+
+static void Bench_GetConfigstring( int num, char *buffer, int bufferSize ) {
+	if ( (unsigned)num >= MAX_CONFIGSTRINGS || !configstrings[ num ] ) {
+		buffer[0] = '\0';
+		return;
+	}
+	Q_strncpyz( buffer, configstrings[ num ], bufferSize );
+}
+
+
+void Bench_SetUserinfo( int clientNum, const char *userinfo ) {
+	Q_strncpyz( userinfos[ clientNum ], userinfo, sizeof( userinfos[0] ) );
+}
+
+
+static void Bench_GetServerinfo( char *buffer, int bufferSize ) {
+	char	info[ MAX_INFO_STRING ];
+	int		i;
+
+	info[0] = '\0';
+	for ( i = 0; i < numCvars; i++ ) {
+		if ( cvars[i].flags & CVAR_SERVERINFO ) {
+			Info_SetValueForKey( info, cvars[i].name, cvars[i].string );
+		}
+	}
+	Q_strncpyz( buffer, info, bufferSize );
+}
+
+
+/*
+================
+Bench_SetCommand
+
+Sets the arguments seen by trap_Argc/trap_Argv, words are split at spaces
+================
+*/
+void Bench_SetCommand( const char *text ) {
+	int len;
+
+	cmdArgc = 0;
+	while ( *text && cmdArgc < MAX_STRING_TOKENS ) {
+		while ( *text == ' ' ) {
+			text++;
+		}
+		if ( !*text ) {
+			break;
+		}
+		len = 0;
+		while ( *text && *text != ' ' ) {
+			if ( len < MAX_TOKEN_CHARS - 1 ) {
+				cmdArgv[ cmdArgc ][ len++ ] = *text;
+			}
+			text++;
+		}
+		cmdArgv[ cmdArgc++ ][ len ] = '\0';
+	}
+}
+
+
+void Bench_SetEntityString( const char *entityString ) {
+	entityParse = entityString;
+}
+
+
+void Bench_SetArgs( int argc, char **argv ) {
+	int i;
+
+	cmdArgc = 0;
+	for ( i = 0; i < argc && i < MAX_STRING_TOKENS; i++ ) {
+		Q_strncpyz( cmdArgv[ cmdArgc++ ], argv[i], sizeof( cmdArgv[0] ) );
+	}
+}
+
+
+/*
+================
+Bench_FOpenFile
+
+Files the game writes go below the current directory, nothing can be read
+================
+*/
+static int Bench_FOpenFile( const char *name, fileHandle_t *f, fsMode_t mode ) {
+	char	path[ MAX_OSPATH ];
+	char	*s;
+	int		i;
+
+	*f = FS_INVALID_HANDLE;
+	if ( mode != FS_WRITE || strstr( name, ".." ) || name[0] == '/' ) {
+		return -1;
+	}
+
+	for ( i = 0; i < MAX_BENCH_FILES; i++ ) {
+		if ( !files[i] ) {
+			break;
+		}
+	}
+	if ( i == MAX_BENCH_FILES ) {
+		return -1;
+	}
+
+	Q_strncpyz( path, name, sizeof( path ) );
+	for ( s = path; *s; s++ ) {
+		if ( *s == '/' ) {
+			*s = '\0';
+			mkdir( path, 0755 );
+			*s = '/';
+		}
+	}
+
+	files[i] = fopen( path, "wb" );
+	if ( !files[i] ) {
+		return -1;
+	}
+
+	*f = i + 1;
+	return 0;
+}
+
+
+/*
+==============================================================================
+
+entity string
+
+==============================================================================
+*/
+
+static qboolean Bench_GetEntityToken( char *buffer, int bufferSize ) {
+	int len;
+
+	buffer[0] = '\0';
+	if ( !entityParse ) {
+		return qfalse;
+	}
+
+	while ( *entityParse && *entityParse <= ' ' ) {
+		entityParse++;
+	}
+	if ( !*entityParse ) {
+		return qfalse;
+	}
+
+	len = 0;
+	if ( *entityParse == '"' ) {
+		entityParse++;
+		while ( *entityParse && *entityParse != '"' ) {
+			if ( len < bufferSize - 1 ) {
+				buffer[ len++ ] = *entityParse;
+			}
+			entityParse++;
+		}
+		if ( *entityParse ) {
+			entityParse++;
+		}
+	} else {
+		while ( *entityParse > ' ' ) {
+			if ( len < bufferSize - 1 ) {
+				buffer[ len++ ] = *entityParse;
+			}
+			entityParse++;
+		}
+	}
+	buffer[ len ] = '\0';
+
+	return qtrue;
+}
+
+
+/*
+==============================================================================
+
+world
+
+==============================================================================
+*/
+
+static void Bench_LinkEntity( sharedEntity_t *ent ) {
+	int i;
+
+	for ( i = 0; i < 3; i++ ) {
+		ent->r.absmin[i] = ent->r.currentOrigin[i] + ent->r.mins[i] - 1;
+		ent->r.absmax[i] = ent->r.currentOrigin[i] + ent->r.maxs[i] + 1;
+	}
+	ent->r.linked = qtrue;
+	ent->r.linkcount++;
+}
+
+
+static void Bench_SetBrushModel( sharedEntity_t *ent, const char *name ) {
+	ent->s.modelindex = atoi( name + 1 );
+	ent->r.bmodel = qtrue;
+	VectorSet( ent->r.mins, -16, -16, -16 );
+	VectorSet( ent->r.maxs, 16, 16, 16 );
+	ent->r.contents = -1;
+}
+
+
+static void Bench_SetPlane( trace_t *tr, int axis, float sign, float dist ) {
+	VectorClear( tr->plane.normal );
+	tr->plane.normal[ axis ] = sign;
+	tr->plane.dist = sign * dist;
+	tr->plane.type = axis;
+	tr->plane.signbits = ( sign < 0 ) ? ( 1 << axis ) : 0;
+}
+
+
+/*
+================
+Bench_ClipToWorld
+
+The world is the inside of a box, anything outside of it is solid
+================
+*/
+static void Bench_ClipToWorld( trace_t *tr, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end ) {
+	float	lo, hi, d, t;
+	int		i;
+
+	for ( i = 0; i < 3; i++ ) {
+		lo = worldMins[i] - mins[i];
+		hi = worldMaxs[i] - maxs[i];
+		if ( start[i] < lo || start[i] > hi ) {
+			tr->allsolid = tr->startsolid = qtrue;
+			tr->fraction = 0;
+			tr->contents = CONTENTS_SOLID;
+			tr->entityNum = ENTITYNUM_WORLD;
+			return;
+		}
+	}
+
+	for ( i = 0; i < 3; i++ ) {
+		lo = worldMins[i] - mins[i];
+		hi = worldMaxs[i] - maxs[i];
+		d = end[i] - start[i];
+		if ( d > 0 && end[i] > hi ) {
+			t = ( hi - start[i] - SURFACE_CLIP_EPSILON ) / d;
+			if ( t < tr->fraction ) {
+				tr->fraction = t < 0 ? 0 : t;
+				Bench_SetPlane( tr, i, -1, worldMaxs[i] );
+				tr->contents = CONTENTS_SOLID;
+				tr->entityNum = ENTITYNUM_WORLD;
+			}
+		} else if ( d < 0 && end[i] < lo ) {
+			t = ( lo - start[i] + SURFACE_CLIP_EPSILON ) / d;
+			if ( t < tr->fraction ) {
+				tr->fraction = t < 0 ? 0 : t;
+				Bench_SetPlane( tr, i, 1, worldMins[i] );
+				tr->contents = CONTENTS_SOLID;
+				tr->entityNum = ENTITYNUM_WORLD;
+			}
+		}
+	}
+}
+
+
+/*
+================
+Bench_ClipToEntity
+
+Slab test of the move against the entity box grown by the move box
+================
+*/
+static void Bench_ClipToEntity( trace_t *tr, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, sharedEntity_t *ent ) {
+	vec3_t	bmin, bmax;
+	float	enter, leave, t0, t1, d, len;
+	int		i, axis;
+	float	sign;
+	qboolean	startIn, endIn;
+
+	startIn = endIn = qtrue;
+	for ( i = 0; i < 3; i++ ) {
+		bmin[i] = ent->r.currentOrigin[i] + ent->r.mins[i] - maxs[i];
+		bmax[i] = ent->r.currentOrigin[i] + ent->r.maxs[i] - mins[i];
+		if ( start[i] <= bmin[i] || start[i] >= bmax[i] ) {
+			startIn = qfalse;
+		}
+		if ( end[i] <= bmin[i] || end[i] >= bmax[i] ) {
+			endIn = qfalse;
+		}
+	}
+
+	if ( startIn ) {
+		tr->startsolid = qtrue;
+		if ( endIn ) {
+			tr->allsolid = qtrue;
+			tr->fraction = 0;
+		}
+		tr->contents = ent->r.contents;
+		tr->entityNum = ent->s.number;
+		return;
+	}
+
+	enter = -1;
+	leave = 1;
+	axis = 0;
+	sign = 1;
+	for ( i = 0; i < 3; i++ ) {
+		d = end[i] - start[i];
+		if ( d == 0 ) {
+			if ( start[i] <= bmin[i] || start[i] >= bmax[i] ) {
+				return;
+			}
+			continue;
+		}
+		t0 = ( bmin[i] - start[i] ) / d;
+		t1 = ( bmax[i] - start[i] ) / d;
+		if ( t0 > t1 ) {
+			float tmp = t0; t0 = t1; t1 = tmp;
+		}
+		if ( t0 > enter ) {
+			enter = t0;
+			axis = i;
+			sign = d > 0 ? -1 : 1;
+		}
+		if ( t1 < leave ) {
+			leave = t1;
+		}
+	}
+
+	if ( enter < 0 || enter > leave || enter >= tr->fraction ) {
+		return;
+	}
+
+	len = Distance( start, end );
+	enter -= SURFACE_CLIP_EPSILON / len;
+	tr->fraction = enter < 0 ? 0 : enter;
+	Bench_SetPlane( tr, axis, sign, sign > 0 ? bmax[axis] : bmin[axis] );
+	tr->contents = ent->r.contents;
+	tr->entityNum = ent->s.number;
+}
+
+
+void Bench_Trace( trace_t *tr, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int passEntityNum, int contentmask ) {
+	sharedEntity_t	*ent;
+	vec3_t			vec3_origin_ = { 0, 0, 0 };
+	int				i, passOwnerNum;
+
+	if ( !mins ) {
+		mins = vec3_origin_;
+	}
+	if ( !maxs ) {
+		maxs = vec3_origin_;
+	}
+
+	memset( tr, 0, sizeof( *tr ) );
+	tr->fraction = 1;
+	tr->entityNum = ENTITYNUM_NONE;
+
+	if ( contentmask & CONTENTS_SOLID ) {
+		Bench_ClipToWorld( tr, start, mins, maxs, end );
+	}
+
+	passOwnerNum = -1;
+	if ( (unsigned)passEntityNum < (unsigned)numGEntities ) {
+		passOwnerNum = GENT( passEntityNum )->r.ownerNum;
+		if ( passOwnerNum == ENTITYNUM_NONE ) {
+			passOwnerNum = -1;
+		}
+	}
+
+	for ( i = 0; i < numGEntities && !tr->allsolid; i++ ) {
+		ent = GENT( i );
+		if ( !ent->r.linked || !( ent->r.contents & contentmask ) ) {
+			continue;
+		}
+		if ( passEntityNum != ENTITYNUM_NONE ) {
+			if ( i == passEntityNum || ent->r.ownerNum == passEntityNum || i == passOwnerNum ) {
+				continue;
+			}
+		}
+		Bench_ClipToEntity( tr, start, mins, maxs, end, ent );
+	}
+
+	for ( i = 0; i < 3; i++ ) {
+		tr->endpos[i] = start[i] + tr->fraction * ( end[i] - start[i] );
+	}
+}
+
+
+int Bench_PointContents( const vec3_t point, int passEntityNum ) {
+	sharedEntity_t	*ent;
+	int				i, j, contents;
+
+	for ( i = 0; i < 3; i++ ) {
+		if ( point[i] < worldMins[i] || point[i] > worldMaxs[i] ) {
+			return CONTENTS_SOLID;
+		}
+	}
+
+	contents = 0;
+	for ( i = 0; i < numGEntities; i++ ) {
+		ent = GENT( i );
+		if ( !ent->r.linked || i == passEntityNum ) {
+			continue;
+		}
+		for ( j = 0; j < 3; j++ ) {
+			if ( point[j] < ent->r.absmin[j] || point[j] > ent->r.absmax[j] ) {
+				break;
+			}
+		}
+		if ( j == 3 ) {
+			contents |= ent->r.contents;
+		}
+	}
+
+	return contents;
+}
+
+
+static qboolean Bench_BoxesTouch( const vec3_t mins1, const vec3_t maxs1, const vec3_t mins2, const vec3_t maxs2 ) {
+	return mins1[0] <= maxs2[0] && maxs1[0] >= mins2[0]
+		&& mins1[1] <= maxs2[1] && maxs1[1] >= mins2[1]
+		&& mins1[2] <= maxs2[2] && maxs1[2] >= mins2[2];
+}
+
+
+static int Bench_EntitiesInBox( const vec3_t mins, const vec3_t maxs, int *list, int maxcount ) {
+	sharedEntity_t	*ent;
+	int				i, count;
+
+	count = 0;
+	for ( i = 0; i < numGEntities && count < maxcount; i++ ) {
+		ent = GENT( i );
+		if ( ent->r.linked && Bench_BoxesTouch( mins, maxs, ent->r.absmin, ent->r.absmax ) ) {
+			list[ count++ ] = i;
+		}
+	}
+
+	return count;
+}
+
+
+/*
+==============================================================================
+
+server
+
+==============================================================================
+*/
+
+void Bench_ResetServer( const char *entityString ) {
+	int i;
+
+	for ( i = 0; i < MAX_CONFIGSTRINGS; i++ ) {
+		free( configstrings[i] );
+		configstrings[i] = NULL;
+	}
+	memset( userinfos, 0, sizeof( userinfos ) );
+	memset( benchCmds, 0, sizeof( benchCmds ) );
+	numCvars = 0;
+	gentities = NULL;
+	numGEntities = 0;
+	gameClients = NULL;
+	entityParse = entityString;
+	serverCommands = 0;
+	cmdArgc = 0;
+}
+
+
+static int Bench_GetValue( char *value, int valueSize, const char *key ) {
+	if ( !Q_stricmp( key, "trap_Microseconds" ) ) {
+		Com_sprintf( value, valueSize, "%i", BENCH_MICROSECONDS );
+		return qtrue;
+	}
+	return qfalse;
+}
+
+
+/*
+================
+Bench_Syscall
+
+Integer-sized arguments only, the game module passes floats through PASSFLOAT
+================
+*/
+intptr_t QDECL Bench_Syscall( intptr_t command, ... ) {
+	intptr_t	a[ 8 ];
+	va_list		ap;
+	int			i;
+
+	va_start( ap, command );
+	for ( i = 0; i < 8; i++ ) {
+		a[i] = va_arg( ap, intptr_t );
+	}
+	va_end( ap );
+
+	switch ( command ) {
+	case G_PRINT:
+		if ( benchVerbose ) {
+			fputs( (const char *)a[0], stdout );
+		}
+		return 0;
+	case G_ERROR:
+		fprintf( stderr, "game error: %s\n", (const char *)a[0] );
+		exit( 1 );
+	case G_MILLISECONDS:
+		return benchTime;
+	case G_CVAR_REGISTER:
+		Bench_RegisterCvar( (vmCvar_t *)a[0], (const char *)a[1], (const char *)a[2], a[3] );
+		return 0;
+	case G_CVAR_UPDATE:
+		Bench_UpdateVmCvar( (vmCvar_t *)a[0] );
+		return 0;
+	case G_CVAR_SET:
+		Bench_SetCvar( (const char *)a[0], (const char *)a[1] );
+		return 0;
+	case G_CVAR_VARIABLE_INTEGER_VALUE:
+		{
+			benchCvar_t *cv = Bench_FindCvar( (const char *)a[0], qfalse );
+			return cv ? atoi( cv->string ) : 0;
+		}
+	case G_CVAR_VARIABLE_STRING_BUFFER:
+		{
+			benchCvar_t *cv = Bench_FindCvar( (const char *)a[0], qfalse );
+			Q_strncpyz( (char *)a[1], cv ? cv->string : "", a[2] );
+			return 0;
+		}
+	case G_ARGC:
+		return cmdArgc;
+	case G_ARGV:
+		Q_strncpyz( (char *)a[1], a[0] < cmdArgc ? cmdArgv[ a[0] ] : "", a[2] );
+		return 0;
+	case G_FS_FOPEN_FILE:
+		return Bench_FOpenFile( (const char *)a[0], (fileHandle_t *)a[1], a[2] );
+	case G_FS_WRITE:
+		if ( (unsigned)( a[2] - 1 ) < MAX_BENCH_FILES && files[ a[2] - 1 ] ) {
+			fwrite( (const void *)a[0], 1, a[1], files[ a[2] - 1 ] );
+		}
+		return 0;
+	case G_FS_FCLOSE_FILE:
+		if ( (unsigned)( a[0] - 1 ) < MAX_BENCH_FILES && files[ a[0] - 1 ] ) {
+			fclose( files[ a[0] - 1 ] );
+			files[ a[0] - 1 ] = NULL;
+		}
+		return 0;
+	case G_FS_READ:
+	case G_FS_SEEK:
+		return 0;
+	case G_FS_GETFILELIST:
+		if ( a[3] > 0 ) {
+			( (char *)a[2] )[0] = '\0';
+		}
+		return 0;
+	case G_SEND_CONSOLE_COMMAND:
+		if ( benchVerbose ) {
+			printf( "console: %s", (const char *)a[1] );
+		}
+		return 0;
+	case G_LOCATE_GAME_DATA:
+		gentities = (byte *)a[0];
+		numGEntities = a[1];
+		sizeofGEntity = a[2];
+		gameClients = (byte *)a[3];
+		sizeofGameClient = a[4];
+		return 0;
+	case G_DROP_CLIENT:
+		if ( benchVerbose ) {
+			printf( "dropped client %i: %s\n", (int)a[0], (const char *)a[1] );
+		}
+		vmMain( GAME_CLIENT_DISCONNECT, a[0], 0, 0 );
+		return 0;
+	case G_SEND_SERVER_COMMAND:
+		serverCommands++;
+		return 0;
+	case G_SET_CONFIGSTRING:
+		Bench_SetConfigstring( a[0], (const char *)a[1] );
+		return 0;
+	case G_GET_CONFIGSTRING:
+		Bench_GetConfigstring( a[0], (char *)a[1], a[2] );
+		return 0;
+	case G_GET_USERINFO:
+		Q_strncpyz( (char *)a[1], userinfos[ a[0] ], a[2] );
+		return 0;
+	case G_SET_USERINFO:
+		Bench_SetUserinfo( a[0], (const char *)a[1] );
+		return 0;
+	case G_GET_SERVERINFO:
+		Bench_GetServerinfo( (char *)a[0], a[1] );
+		return 0;
+	case G_SET_BRUSH_MODEL:
+		Bench_SetBrushModel( (sharedEntity_t *)a[0], (const char *)a[1] );
+		return 0;
+	case G_TRACE:
+	case G_TRACECAPSULE:
+		Bench_Trace( (trace_t *)a[0], (const float *)a[1], (const float *)a[2], (const float *)a[3], (const float *)a[4], a[5], a[6] );
+		return 0;
+	case G_POINT_CONTENTS:
+		return Bench_PointContents( (const float *)a[0], a[1] );
+	case G_IN_PVS:
+	case G_IN_PVS_IGNORE_PORTALS:
+	case G_AREAS_CONNECTED:
+		return qtrue;
+	case G_ADJUST_AREA_PORTAL_STATE:
+		return 0;
+	case G_LINKENTITY:
+		Bench_LinkEntity( (sharedEntity_t *)a[0] );
+		return 0;
+	case G_UNLINKENTITY:
+		( (sharedEntity_t *)a[0] )->r.linked = qfalse;
+		return 0;
+	case G_ENTITIES_IN_BOX:
+		return Bench_EntitiesInBox( (const float *)a[0], (const float *)a[1], (int *)a[2], a[3] );
+	case G_ENTITY_CONTACT:
+	case G_ENTITY_CONTACTCAPSULE:
+		{
+			const sharedEntity_t *ent = (const sharedEntity_t *)a[2];
+			return Bench_BoxesTouch( (const float *)a[0], (const float *)a[1], ent->r.absmin, ent->r.absmax );
+		}
+	case G_BOT_ALLOCATE_CLIENT:
+		return -1;
+	case G_BOT_FREE_CLIENT:
+		return 0;
+	case G_GET_USERCMD:
+		*(usercmd_t *)a[1] = benchCmds[ a[0] ];
+		return 0;
+	case G_GET_ENTITY_TOKEN:
+		return Bench_GetEntityToken( (char *)a[0], a[1] );
+	case G_DEBUG_POLYGON_CREATE:
+	case G_DEBUG_POLYGON_DELETE:
+		return 0;
+	case G_REAL_TIME:
+		{
+			qtime_t		*qtime = (qtime_t *)a[0];
+			time_t		t = time( NULL );
+			struct tm	*tm = localtime( &t );
+
+			if ( qtime ) {
+				qtime->tm_sec = tm->tm_sec;
+				qtime->tm_min = tm->tm_min;
+				qtime->tm_hour = tm->tm_hour;
+				qtime->tm_mday = tm->tm_mday;
+				qtime->tm_mon = tm->tm_mon;
+				qtime->tm_year = tm->tm_year;
+				qtime->tm_wday = tm->tm_wday;
+				qtime->tm_yday = tm->tm_yday;
+				qtime->tm_isdst = tm->tm_isdst;
+			}
+			return t;
+		}
+	case G_SNAPVECTOR:
+		{
+			float *v = (float *)a[0];
+			v[0] = (int)( v[0] < 0 ? v[0] - 0.5f : v[0] + 0.5f );
+			v[1] = (int)( v[1] < 0 ? v[1] - 0.5f : v[1] + 0.5f );
+			v[2] = (int)( v[2] < 0 ? v[2] - 0.5f : v[2] + 0.5f );
+			return 0;
+		}
+	case BENCH_GET_VALUE:
+		return Bench_GetValue( (char *)a[0], a[1], (const char *)a[2] );
+	case BENCH_MICROSECONDS:
+		return Bench_Microseconds();
+	}
+
+	// no botlib
+	return 0;
+}
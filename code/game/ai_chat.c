@@ -47,15 +47,13 @@ BotNumActivePlayers
 */
 int BotNumActivePlayers(void) {
 	int i, num;
-	char buf[MAX_INFO_STRING];
 
 	num = 0;
 	for (i = 0; i < level.maxclients; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
 		//if no config string or no name
-		if (!buf[0] || !*Info_ValueForKey(buf, "n")) continue;
+		if (!level.playerInfo[i].valid) continue;
 		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		if (level.playerInfo[i].team == TEAM_SPECTATOR) continue;
 		//
 		num++;
 	}
@@ -69,16 +67,14 @@ BotIsFirstInRankings
 */
 int BotIsFirstInRankings(bot_state_t *bs) {
 	int i, score;
-	char buf[MAX_INFO_STRING];
 	playerState_t ps;
 
 	score = bs->cur_ps.persistant[PERS_SCORE];
 	for (i = 0; i < level.maxclients; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
 		//if no config string or no name
-		if (!buf[0] || !*Info_ValueForKey(buf, "n")) continue;
+		if (!level.playerInfo[i].valid) continue;
 		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		if (level.playerInfo[i].team == TEAM_SPECTATOR) continue;
 		//
 		BotAI_GetClientState(i, &ps);
 		if (score < ps.persistant[PERS_SCORE]) return qfalse;
@@ -93,16 +89,14 @@ BotIsLastInRankings
 */
 int BotIsLastInRankings(bot_state_t *bs) {
 	int i, score;
-	char buf[MAX_INFO_STRING];
 	playerState_t ps;
 
 	score = bs->cur_ps.persistant[PERS_SCORE];
 	for (i = 0; i < level.maxclients; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
 		//if no config string or no name
-		if (!buf[0] || !*Info_ValueForKey(buf, "n")) continue;
+		if (!level.playerInfo[i].valid) continue;
 		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		if (level.playerInfo[i].team == TEAM_SPECTATOR) continue;
 		//
 		BotAI_GetClientState(i, &ps);
 		if (score > ps.persistant[PERS_SCORE]) return qfalse;
@@ -117,18 +111,16 @@ BotFirstClientInRankings
 */
 char *BotFirstClientInRankings(void) {
 	int i, bestscore, bestclient;
-	char buf[MAX_INFO_STRING];
 	static char name[32];
 	playerState_t ps;
 
 	bestscore = -999999;
 	bestclient = 0;
 	for (i = 0; i < level.maxclients; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
 		//if no config string or no name
-		if (!buf[0] || !*Info_ValueForKey(buf, "n")) continue;
+		if (!level.playerInfo[i].valid) continue;
 		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		if (level.playerInfo[i].team == TEAM_SPECTATOR) continue;
 		//
 		BotAI_GetClientState(i, &ps);
 		if (ps.persistant[PERS_SCORE] > bestscore) {
@@ -148,18 +140,16 @@ BotLastClientInRankings
 */
 char *BotLastClientInRankings(void) {
 	int i, worstscore, bestclient;
-	char buf[MAX_INFO_STRING];
 	static char name[32];
 	playerState_t ps;
 
 	worstscore = 999999;
 	bestclient = 0;
 	for (i = 0; i < level.maxclients; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
 		//if no config string or no name
-		if (!buf[0] || !*Info_ValueForKey(buf, "n")) continue;
+		if (!level.playerInfo[i].valid) continue;
 		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		if (level.playerInfo[i].team == TEAM_SPECTATOR) continue;
 		//
 		BotAI_GetClientState(i, &ps);
 		if (ps.persistant[PERS_SCORE] < worstscore) {
@@ -179,7 +169,6 @@ BotRandomOpponentName
 */
 char *BotRandomOpponentName(bot_state_t *bs) {
 	int i, count;
-	char buf[MAX_INFO_STRING];
 	int opponents[MAX_CLIENTS], numopponents;
 	static char name[32];
 
@@ -188,11 +177,10 @@ char *BotRandomOpponentName(bot_state_t *bs) {
 	for (i = 0; i < level.maxclients; i++) {
 		if (i == bs->client) continue;
 		//
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
 		//if no config string or no name
-		if (!buf[0] || !*Info_ValueForKey(buf, "n")) continue;
+		if (!level.playerInfo[i].valid) continue;
 		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		if (level.playerInfo[i].team == TEAM_SPECTATOR) continue;
 		//skip team mates
 		if (BotSameTeam(bs, i)) continue;
 		//
@@ -269,12 +269,10 @@ NumPlayersOnSameTeam
 */
 int NumPlayersOnSameTeam(bot_state_t *bs) {
 	int i, num;
-	char buf[MAX_INFO_STRING];
 
 	num = 0;
 	for (i = 0; i < level.maxclients; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, MAX_INFO_STRING);
-		if (buf[0]) {
+		if (level.playerInfo[i].valid) {
 			if (BotSameTeam(bs, i+1)) num++;
 		}
 	}
@@ -1556,8 +1554,8 @@ void BotMatch_WhereAreYou(bot_state_t *bs, bot_match_t *match) {
 			|| gametype == GT_1FCTF
 #endif
 			) {
-			redtt = trap_AAS_AreaTravelTimeToGoalArea(bs->areanum, bs->origin, ctf_redflag.areanum, TFL_DEFAULT);
-			bluett = trap_AAS_AreaTravelTimeToGoalArea(bs->areanum, bs->origin, ctf_blueflag.areanum, TFL_DEFAULT);
+			redtt = BotCachedTravelTime(bs->areanum, bs->origin, ctf_redflag.areanum, TFL_DEFAULT);
+			bluett = BotCachedTravelTime(bs->areanum, bs->origin, ctf_blueflag.areanum, TFL_DEFAULT);
 			if (redtt < (redtt + bluett) * 0.4) {
 				BotAI_BotInitialChat(bs, "teamlocation", nearbyitems[bestitem], "red", NULL);
 			}
@@ -1570,8 +1568,8 @@ void BotMatch_WhereAreYou(bot_state_t *bs, bot_match_t *match) {
 		}
 #ifdef MISSIONPACK
 		else if (gametype == GT_OBELISK || gametype == GT_HARVESTER) {
-			redtt = trap_AAS_AreaTravelTimeToGoalArea(bs->areanum, bs->origin, redobelisk.areanum, TFL_DEFAULT);
-			bluett = trap_AAS_AreaTravelTimeToGoalArea(bs->areanum, bs->origin, blueobelisk.areanum, TFL_DEFAULT);
+			redtt = BotCachedTravelTime(bs->areanum, bs->origin, redobelisk.areanum, TFL_DEFAULT);
+			bluett = BotCachedTravelTime(bs->areanum, bs->origin, blueobelisk.areanum, TFL_DEFAULT);
 			if (redtt < (redtt + bluett) * 0.4) {
 				BotAI_BotInitialChat(bs, "teamlocation", nearbyitems[bestitem], "red", NULL);
 			}
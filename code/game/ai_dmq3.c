@@ -124,16 +124,16 @@ BotTeam
 ==================
 */
 int BotTeam(bot_state_t *bs) {
-	char info[1024];
+	int team;
 
 	if (bs->client < 0 || bs->client >= MAX_CLIENTS) {
 		//BotAI_Print(PRT_ERROR, "BotCTFTeam: client out of range\n");
 		return qfalse;
 	}
-	trap_GetConfigstring(CS_PLAYERS+bs->client, info, sizeof(info));
+	team = level.playerInfo[bs->client].team;
 	//
-	if (atoi(Info_ValueForKey(info, "t")) == TEAM_RED) return TEAM_RED;
-	else if (atoi(Info_ValueForKey(info, "t")) == TEAM_BLUE) return TEAM_BLUE;
+	if (team == TEAM_RED) return TEAM_RED;
+	else if (team == TEAM_BLUE) return TEAM_BLUE;
 	return TEAM_FREE;
 }
 
@@ -1385,7 +1385,6 @@ ClientName
 ==================
 */
 char *ClientName( int client, char *name, int size ) {
-	char buf[ MAX_INFO_STRING ];
 
 	if ( (unsigned) client >= MAX_CLIENTS ) {
 		BotAI_Print( PRT_ERROR, "ClientName: client out of range\n" );
@@ -1393,9 +1392,7 @@ char *ClientName( int client, char *name, int size ) {
 		return name;
 	}
 
-	trap_GetConfigstring( CS_PLAYERS + client, buf, sizeof( buf ) );
-	Q_strncpyz( name, Info_ValueForKey( buf, "n" ), size );
-	Q_CleanStr( name );
+	Q_strncpyz( name, level.playerInfo[ client ].cleanname, size );
 
 	return name;
 }
@@ -1407,15 +1404,13 @@ ClientSkin
 ==================
 */
 char *ClientSkin( int client, char *skin, int size ) {
-	char buf[ MAX_INFO_STRING ];
 
 	if ( (unsigned) client >= MAX_CLIENTS ) {
 		BotAI_Print(PRT_ERROR, "ClientSkin: client out of range\n");
 		return "[client out of range]";
 	}
 
-	trap_GetConfigstring( CS_PLAYERS + client, buf, sizeof( buf ) );
-	Q_strncpyz( skin, Info_ValueForKey( buf, "model" ), size );
+	Q_strncpyz( skin, level.playerInfo[ client ].model, size );
 
 	return skin;
 }
@@ -1428,12 +1423,9 @@ ClientFromName
 */
 int ClientFromName( const char *name ) {
 	int i;
-	char buf[ MAX_INFO_STRING ];
 
 	for ( i = 0; i < level.maxclients; i++ ) {
-		trap_GetConfigstring( CS_PLAYERS + i, buf, sizeof( buf ) );
-		Q_CleanStr( buf );
-		if ( !Q_stricmp( Info_ValueForKey( buf, "n" ), name ) )
+		if ( !Q_stricmp( level.playerInfo[ i ].cleanname, name ) )
 			return i;
 	}
 	return -1;
@@ -1446,15 +1438,12 @@ ClientOnSameTeamFromName
 ==================
 */
 int ClientOnSameTeamFromName( bot_state_t *bs, const char *name ) {
-	char buf[MAX_INFO_STRING];
 	int i;
 
 	for ( i = 0; i < level.maxclients; i++ ) {
 		if ( !BotSameTeam( bs, i ) )
 			continue;
-		trap_GetConfigstring( CS_PLAYERS + i, buf, sizeof( buf ) );
-		Q_CleanStr( buf );
-		if ( !Q_stricmp( Info_ValueForKey( buf, "n" ), name ) )
+		if ( !Q_stricmp( level.playerInfo[ i ].cleanname, name ) )
 			return i;
 	}
 
@@ -2093,10 +2082,8 @@ BotIsObserver
 ==================
 */
 qboolean BotIsObserver(bot_state_t *bs) {
-	char buf[MAX_INFO_STRING];
 	if (bs->cur_ps.pm_type == PM_SPECTATOR) return qtrue;
-	trap_GetConfigstring(CS_PLAYERS+bs->client, buf, sizeof(buf));
-	if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) return qtrue;
+	if (level.playerInfo[bs->client].team == TEAM_SPECTATOR) return qtrue;
 	return qfalse;
 }
 
@@ -2828,30 +2815,17 @@ qboolean InFieldOfVision(vec3_t viewangles, float fov, vec3_t angles)
 
 /*
 ==================
-BotEntityVisible
+BotTraceVisibility
 
-returns visibility in the range [0, 1] taking fog and water surfaces into account
+the traces behind BotEntityVisible, from the eye to the middle, bottom and top of the entity
 ==================
 */
-float BotEntityVisible(int viewer, vec3_t eye, vec3_t viewangles, float fov, int ent) {
+static float BotTraceVisibility(int viewer, vec3_t eye, int ent, aas_entityinfo_t *entinfo, vec3_t middle) {
 	int i, contents_mask, passent, hitent, infog, inwater, otherinfog, pc;
 	float squaredfogdist, waterfactor, vis, bestvis;
 	bsp_trace_t trace;
-	aas_entityinfo_t entinfo;
-	vec3_t dir, entangles, start, end, middle;
+	vec3_t dir, start, end;
 
-	//calculate middle of bounding box
-	BotEntityInfo(ent, &entinfo);
-	if (!entinfo.valid)
-		return 0;
-	VectorAdd(entinfo.mins, entinfo.maxs, middle);
-	VectorScale(middle, 0.5, middle);
-	VectorAdd(entinfo.origin, middle, middle);
-	//check if entity is within field of vision
-	VectorSubtract(middle, eye, dir);
-	vectoangles(dir, entangles);
-	if (!InFieldOfVision(viewangles, fov, entangles)) return 0;
-	//
 	pc = trap_AAS_PointContents(eye);
 	infog = (pc & CONTENTS_FOG);
 	inwater = (pc & (CONTENTS_LAVA|CONTENTS_SLIME|CONTENTS_WATER));
@@ -2882,6 +2856,7 @@ float BotEntityVisible(int viewer, vec3_t eye, vec3_t viewangles, float fov, int
 		}
 		//trace from start to end
 		BotAI_Trace(&trace, start, NULL, NULL, end, passent, contents_mask);
+		botAIStats.visTraces++;
 		//if water was hit
 		waterfactor = 1.0;
 		if (trace.contents & (CONTENTS_LAVA|CONTENTS_SLIME|CONTENTS_WATER)) {
@@ -2890,6 +2865,7 @@ float BotEntityVisible(int viewer, vec3_t eye, vec3_t viewangles, float fov, int
 				//trace through the water
 				contents_mask &= ~(CONTENTS_LAVA|CONTENTS_SLIME|CONTENTS_WATER);
 				BotAI_Trace(&trace, trace.endpos, NULL, NULL, end, passent, contents_mask);
+				botAIStats.visTraces++;
 				waterfactor = 0.5;
 			}
 		}
@@ -2905,12 +2881,14 @@ float BotEntityVisible(int viewer, vec3_t eye, vec3_t viewangles, float fov, int
 			else if (infog) {
 				VectorCopy(trace.endpos, start);
 				BotAI_Trace(&trace, start, NULL, NULL, eye, viewer, CONTENTS_FOG);
+				botAIStats.visTraces++;
 				VectorSubtract(eye, trace.endpos, dir);
 				squaredfogdist = VectorLengthSquared(dir);
 			}
 			else if (otherinfog) {
 				VectorCopy(trace.endpos, end);
 				BotAI_Trace(&trace, eye, NULL, NULL, end, viewer, CONTENTS_FOG);
+				botAIStats.visTraces++;
 				VectorSubtract(end, trace.endpos, dir);
 				squaredfogdist = VectorLengthSquared(dir);
 			}
@@ -2928,12 +2906,151 @@ float BotEntityVisible(int viewer, vec3_t eye, vec3_t viewangles, float fov, int
 			if (bestvis >= 0.95) return bestvis;
 		}
 		//check bottom and top of bounding box as well
-		if (i == 0) middle[2] += entinfo.mins[2];
-		else if (i == 1) middle[2] += entinfo.maxs[2] - entinfo.mins[2];
+		if (i == 0) middle[2] += entinfo->mins[2];
+		else if (i == 1) middle[2] += entinfo->maxs[2] - entinfo->mins[2];
 	}
 	return bestvis;
 }
 
+//bot visibility cache, see BotEntityVisible
+#define BOTVIS_CACHE_SIZE		1024	//power of 2
+#define BOTVIS_EYE_CELL			8
+
+typedef struct botvisentry_s
+{
+	int time;						//level.time the entry was made
+	int viewer, ent;
+	int eyecell[3];
+	int traces;						//traces it took to work out vis
+	float vis;
+} botvisentry_t;
+
+static botvisentry_t botviscache[BOTVIS_CACHE_SIZE];
+
+/*
+==================
+BotClearVisibilityCache
+==================
+*/
+static void BotClearVisibilityCache(void) {
+	int i;
+
+	for (i = 0; i < BOTVIS_CACHE_SIZE; i++) {
+		botviscache[i].time = -1;
+	}
+}
+
+/*
+==================
+BotEntityVisible
+
+returns visibility in the range [0, 1] taking fog and water surfaces into account
+
+Bots ask about the same entities several times in a think, from BotFindEnemy,
+BotVisibleTeamMatesAndEnemies, the ai nodes and the team ai, so the result of the
+traces is kept for the rest of the server frame keyed by the viewer, the entity and
+the eye position rounded to BOTVIS_EYE_CELL units.  The field of vision is checked
+on every call since it depends on the view angles.
+==================
+*/
+float BotEntityVisible(int viewer, vec3_t eye, vec3_t viewangles, float fov, int ent) {
+	int i, eyecell[3], traces;
+	aas_entityinfo_t entinfo;
+	vec3_t dir, entangles, middle;
+	botvisentry_t *cached;
+
+	//calculate middle of bounding box
+	BotEntityInfo(ent, &entinfo);
+	if (!entinfo.valid)
+		return 0;
+	VectorAdd(entinfo.mins, entinfo.maxs, middle);
+	VectorScale(middle, 0.5, middle);
+	VectorAdd(entinfo.origin, middle, middle);
+	//check if entity is within field of vision
+	VectorSubtract(middle, eye, dir);
+	vectoangles(dir, entangles);
+	if (!InFieldOfVision(viewangles, fov, entangles)) return 0;
+	//
+	for (i = 0; i < 3; i++) {
+		eyecell[i] = (int) (eye[i] * (1.0f / BOTVIS_EYE_CELL));
+	}
+	cached = &botviscache[(viewer * 1031 + ent) & (BOTVIS_CACHE_SIZE - 1)];
+	botAIStats.visLookups++;
+	if (cached->time == level.time && cached->viewer == viewer && cached->ent == ent &&
+		cached->eyecell[0] == eyecell[0] && cached->eyecell[1] == eyecell[1] && cached->eyecell[2] == eyecell[2]) {
+		botAIStats.visHits++;
+		botAIStats.visTracesSaved += cached->traces;
+		return cached->vis;
+	}
+	//
+	traces = botAIStats.visTraces;
+	cached->vis = BotTraceVisibility(viewer, eye, ent, &entinfo, middle);
+	cached->traces = botAIStats.visTraces - traces;
+	cached->time = level.time;
+	cached->viewer = viewer;
+	cached->ent = ent;
+	cached->eyecell[0] = eyecell[0];
+	cached->eyecell[1] = eyecell[1];
+	cached->eyecell[2] = eyecell[2];
+	return cached->vis;
+}
+
+//travel time cache, see BotCachedTravelTime
+#define BOTTRAVEL_CACHE_SIZE	256		//power of 2
+#define BOTTRAVEL_CACHE_TIME	1000	//msec an entry is used
+
+typedef struct bottravelentry_s
+{
+	int time;						//level.time the entry was made
+	int areanum, goalareanum;		//areanum 0 is an empty slot
+	int travelflags;
+	int traveltime;
+} bottravelentry_t;
+
+static bottravelentry_t bottravelcache[BOTTRAVEL_CACHE_SIZE];
+
+/*
+==================
+BotClearTravelTimeCache
+==================
+*/
+static void BotClearTravelTimeCache(void) {
+	memset(bottravelcache, 0, sizeof(bottravelcache));
+}
+
+/*
+==================
+BotCachedTravelTime
+
+trap_AAS_AreaTravelTimeToGoalArea for the team ai, which asks for the travel times
+of all team mates to the bases whenever it hands out orders.  The answer is kept for
+BOTTRAVEL_CACHE_TIME keyed by the start area, the goal area and the travel flags and
+shared by all bots, so the position inside the start area of whoever asked first is
+what counts for the others.  Good enough for ranking team mates, not for steering.
+==================
+*/
+int BotCachedTravelTime(int areanum, vec3_t origin, int goalareanum, int travelflags) {
+	bottravelentry_t *cached;
+
+	if (!areanum) {
+		return trap_AAS_AreaTravelTimeToGoalArea(areanum, origin, goalareanum, travelflags);
+	}
+	cached = &bottravelcache[(areanum * 1031 + goalareanum * 7 + travelflags) & (BOTTRAVEL_CACHE_SIZE - 1)];
+	botAIStats.travelLookups++;
+	if (cached->areanum == areanum && cached->goalareanum == goalareanum && cached->travelflags == travelflags &&
+		level.time >= cached->time && level.time < cached->time + BOTTRAVEL_CACHE_TIME) {
+		botAIStats.travelHits++;
+		return cached->traveltime;
+	}
+	//
+	cached->traveltime = trap_AAS_AreaTravelTimeToGoalArea(areanum, origin, goalareanum, travelflags);
+	cached->time = level.time;
+	cached->areanum = areanum;
+	cached->goalareanum = goalareanum;
+	cached->travelflags = travelflags;
+	return cached->traveltime;
+}
+
 /*
 ==================
 BotFindEnemy
@@ -5411,6 +5528,9 @@ void BotSetupDeathmatchAI(void) {
 
 	gametype = trap_Cvar_VariableIntegerValue( "g_gametype" );
 
+	BotClearVisibilityCache();
+	BotClearTravelTimeCache();
+
 	trap_Cvar_Register(&bot_rocketjump, "bot_rocketjump", "1", 0);
 	trap_Cvar_Register(&bot_grapple, "bot_grapple", "0", 0);
 	trap_Cvar_Register(&bot_fastchat, "bot_fastchat", "0", 0);
@@ -98,6 +98,8 @@ int BotFindEnemy(bot_state_t *bs, int curenemy);
 void BotRoamGoal(bot_state_t *bs, vec3_t goal);
 //returns entity visibility in the range [0, 1]
 float BotEntityVisible(int viewer, vec3_t eye, vec3_t viewangles, float fov, int ent);
+//returns the travel time from the area to the goal area, shared between bots for a while
+int BotCachedTravelTime(int areanum, vec3_t origin, int goalareanum, int travelflags);
 //the bot will aim at the current enemy
 void BotAimAtEnemy(bot_state_t *bs);
 //check if the bot should attack
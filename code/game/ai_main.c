@@ -43,6 +43,8 @@ bot_state_t	*botstates[MAX_CLIENTS];
 int numbots;
 //floating point time
 float floattime;
+//ai cache counters
+botaistats_t botAIStats;
 //time to do a regular update
 float regularupdate_time;
 //
@@ -50,6 +52,7 @@ int bot_interbreed;
 int bot_interbreedmatchcount;
 //
 vmCvar_t bot_thinktime;
+vmCvar_t bot_thinkbudget;
 vmCvar_t bot_memorydump;
 vmCvar_t bot_saveroutingcache;
 vmCvar_t bot_pause;
@@ -370,6 +373,69 @@ void BotReportStatus(bot_state_t *bs) {
 	}
 }
 
+static int nextbotreport;
+
+/*
+==================
+BotAIClearReport
+
+clears the counters BotAIPrintReport prints, called every frame while bot_report
+is off so they can't grow until they overflow
+==================
+*/
+static void BotAIClearReport(void) {
+	bot_state_t *bs;
+	int i;
+
+	memset(&botAIStats, 0, sizeof(botAIStats));
+	for (i = 0; i < MAX_CLIENTS; i++) {
+		bs = botstates[i];
+		if (!bs) continue;
+		bs->thinkcount = 0;
+		bs->thinkusec = 0;
+		bs->thinkmaxusec = 0;
+		bs->thinkdeferred = 0;
+	}
+	nextbotreport = level.time + BOT_REPORT_TIME;
+}
+
+/*
+==================
+BotAIPrintReport
+
+prints the ai cache counters every BOT_REPORT_TIME while bot_report is set
+==================
+*/
+static void BotAIPrintReport(void) {
+	char name[MAX_NETNAME];
+	bot_state_t *bs;
+	int i, pct;
+
+	if (level.time < nextbotreport && level.time > nextbotreport - BOT_REPORT_TIME) {
+		return;
+	}
+	//
+	pct = botAIStats.visLookups ? botAIStats.visHits * 100 / botAIStats.visLookups : 0;
+	BotAI_Print(PRT_MESSAGE, "visibility: %d lookups, %d%% cached, %d traces, %d saved\n",
+		botAIStats.visLookups, pct, botAIStats.visTraces, botAIStats.visTracesSaved);
+	BotAI_Print(PRT_MESSAGE, "botlib entities: %d updates, %d removals\n",
+		botAIStats.entUpdates, botAIStats.entRemovals);
+	pct = botAIStats.travelLookups ? botAIStats.travelHits * 100 / botAIStats.travelLookups : 0;
+	BotAI_Print(PRT_MESSAGE, "travel times: %d lookups, %d%% cached\n",
+		botAIStats.travelLookups, pct);
+	//
+	BotAI_Print(PRT_MESSAGE, "bot thinks, budget %d usec a frame:\n", bot_thinkbudget.integer);
+	for (i = 0; i < level.maxclients; i++) {
+		bs = botstates[i];
+		if (!bs || !bs->inuse) continue;
+		ClientName(i, name, sizeof(name));
+		BotAI_Print(PRT_MESSAGE, "%-20s %4d thinks, avg %5d max %6d usec, %3d deferred, every %d msec\n",
+			name, bs->thinkcount, bs->thinkcount ? bs->thinkusec / bs->thinkcount : 0, bs->thinkmaxusec,
+			bs->thinkdeferred, bot_thinktime.integer * bs->thinkscale);
+	}
+	BotAIClearReport();
+}
+
 /*
 ==================
 BotTeamplayReport
@@ -377,18 +443,16 @@ BotTeamplayReport
 */
 void BotTeamplayReport(void) {
 	int i;
-	char buf[MAX_INFO_STRING];
 
 	BotAI_Print(PRT_MESSAGE, S_COLOR_RED"RED\n");
 	for (i = 0; i < level.maxclients; i++) {
 		//
 		if ( !botstates[i] || !botstates[i]->inuse ) continue;
 		//
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
 		//if no config string or no name
-		if (!buf[0] || !*Info_ValueForKey(buf, "n")) continue;
+		if (!level.playerInfo[i].valid) continue;
 		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_RED) {
+		if (level.playerInfo[i].team == TEAM_RED) {
 			BotReportStatus(botstates[i]);
 		}
 	}
@@ -397,11 +461,10 @@ void BotTeamplayReport(void) {
 		//
 		if ( !botstates[i] || !botstates[i]->inuse ) continue;
 		//
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
 		//if no config string or no name
-		if (!buf[0] || !*Info_ValueForKey(buf, "n")) continue;
+		if (!level.playerInfo[i].valid) continue;
 		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_BLUE) {
+		if (level.playerInfo[i].team == TEAM_BLUE) {
 			BotReportStatus(botstates[i]);
 		}
 	}
@@ -532,16 +595,14 @@ BotUpdateInfoConfigStrings
 */
 void BotUpdateInfoConfigStrings(void) {
 	int i;
-	char buf[MAX_INFO_STRING];
 
 	for (i = 0; i < level.maxclients; i++) {
 		//
 		if ( !botstates[i] || !botstates[i]->inuse )
 			continue;
 		//
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
 		//if no config string or no name
-		if (!buf[0] || !*Info_ValueForKey(buf, "n"))
+		if (!level.playerInfo[i].valid)
 			continue;
 		BotSetInfoConfigString(botstates[i]);
 	}
@@ -1078,6 +1139,56 @@ void BotScheduleBotThink(void) {
 	}
 }
 
+/*
+==================
+BotScheduleNewBot
+
+puts the think of a bot that joins in the middle of the largest gap between the
+thinks of the bots already playing, instead of rescheduling all of them
+==================
+*/
+static void BotScheduleNewBot(bot_state_t *bs) {
+	int phases[MAX_CLIENTS], numphases;
+	int i, j, p, gap, bestgap, best, thinktime;
+
+	thinktime = bot_thinktime.integer > 0 ? bot_thinktime.integer : 1;
+	numphases = 0;
+	for (i = 0; i < MAX_CLIENTS; i++) {
+		if (!botstates[i] || !botstates[i]->inuse || botstates[i] == bs) {
+			continue;
+		}
+		p = botstates[i]->botthink_residual % thinktime;
+		if (p < 0) p += thinktime;
+		//insertion sort, there are only a few
+		for (j = numphases; j > 0 && phases[j - 1] > p; j--) {
+			phases[j] = phases[j - 1];
+		}
+		phases[j] = p;
+		numphases++;
+	}
+	//
+	best = 0;
+	if (numphases) {
+		//the gap that wraps around from the last phase to the first
+		bestgap = phases[0] + thinktime - phases[numphases - 1];
+		best = (phases[numphases - 1] + bestgap / 2) % thinktime;
+		for (i = 1; i < numphases; i++) {
+			gap = phases[i] - phases[i - 1];
+			if (gap > bestgap) {
+				bestgap = gap;
+				best = phases[i - 1] + gap / 2;
+			}
+		}
+	}
+	//
+	bs->botthink_residual = best;
+	bs->thinkscale = 1;
+	bs->thinkcount = 0;
+	bs->thinkusec = 0;
+	bs->thinkmaxusec = 0;
+	bs->thinkdeferred = 0;
+}
+
 /*
 ==============
 BotWriteSessionData
@@ -1163,7 +1274,8 @@ qboolean BotAISetupClient( int client, struct bot_settings_s *settings, qboolean
 	bot_state_t *bs;
 	int errnum;
 
-	if (!botstates[client]) botstates[client] = G_Alloc(sizeof(bot_state_t));
+	// bot states are kept between maps
+	if (!botstates[client]) botstates[client] = G_ArenaAlloc(MEM_PERSISTENT, sizeof(bot_state_t));
 	bs = botstates[client];
 	if ( bs == NULL ) {
 		return qfalse;
@@ -1238,8 +1350,8 @@ qboolean BotAISetupClient( int client, struct bot_settings_s *settings, qboolean
 		trap_BotLibVarSet("bot_testichat", "1");
 		BotChatTest(bs);
 	}
-	//NOTE: reschedule the bot thinking
-	BotScheduleBotThink();
+	//fit the bot in between the others
+	BotScheduleNewBot(bs);
 	//if interbreeding start with a mutation
 	if (bot_interbreed) {
 		trap_BotMutateGoalFuzzyLogic(bs->gs, 1);
@@ -1314,6 +1426,7 @@ void BotResetState(bot_state_t *bs) {
 	int character;
 	playerState_t ps;							//current player state
 	float entergame_time;
+	int botthink_residual, thinkscale, thinkcount, thinkusec, thinkmaxusec, thinkdeferred;
 
 	//save some things that should not be reset here
 	memcpy(&settings, &bs->settings, sizeof(bot_settings_t));
@@ -1327,6 +1440,13 @@ void BotResetState(bot_state_t *bs) {
 	chatstate = bs->cs;
 	weaponstate = bs->ws;
 	entergame_time = bs->entergame_time;
+	//keep the think schedule, bots would all end up thinking in the same frame otherwise
+	botthink_residual = bs->botthink_residual;
+	thinkscale = bs->thinkscale;
+	thinkcount = bs->thinkcount;
+	thinkusec = bs->thinkusec;
+	thinkmaxusec = bs->thinkmaxusec;
+	thinkdeferred = bs->thinkdeferred;
 	//free checkpoints and patrol points
 	BotFreeWaypoints(bs->checkpoints);
 	BotFreeWaypoints(bs->patrolpoints);
@@ -1344,6 +1464,12 @@ void BotResetState(bot_state_t *bs) {
 	bs->entitynum = entitynum;
 	bs->character = character;
 	bs->entergame_time = entergame_time;
+	bs->botthink_residual = botthink_residual;
+	bs->thinkscale = thinkscale;
+	bs->thinkcount = thinkcount;
+	bs->thinkusec = thinkusec;
+	bs->thinkmaxusec = thinkmaxusec;
+	bs->thinkdeferred = thinkdeferred;
 	//reset several states
 	if (bs->ms) trap_BotResetMoveState(bs->ms);
 	if (bs->gs) trap_BotResetGoalState(bs->gs);
@@ -1384,6 +1510,109 @@ int BotAILoadMap( int restart ) {
 void ProximityMine_Trigger( gentity_t *trigger, gentity_t *other, trace_t *trace );
 #endif
 
+/*
+==================
+BotFarFromHumans
+==================
+*/
+static qboolean BotFarFromHumans(bot_state_t *bs) {
+	gentity_t *ent;
+	vec3_t dir;
+	int i;
+
+	for (i = 0; i < level.maxclients; i++) {
+		ent = &g_entities[i];
+		if (!ent->inuse || ent->r.svFlags & SVF_BOT) continue;
+		if (ent->client->pers.connected != CON_CONNECTED) continue;
+		VectorSubtract(ent->r.currentOrigin, bs->origin, dir);
+		if (VectorLengthSquared(dir) < Square(BOT_FAR_FROM_HUMANS)) return qfalse;
+	}
+	return qtrue;
+}
+
+/*
+==================
+BotRunThinks
+
+runs BotAI for the bots whose think interval is up, the most overdue first
+
+With bot_thinkbudget set no more bots start thinking in a frame once that many
+microseconds have been spent, the rest wait for the next frame.  While the
+budget keeps running out the bots away from all humans think less often, up to
+BOT_MAX_THINK_SCALE times bot_thinktime, and go back to normal once it doesn't.
+==================
+*/
+static qboolean BotRunThinks(int elapsed_time, int thinktime) {
+	static int lastoverload;
+	bot_state_t *bs;
+	int due[MAX_CLIENTS], overdue[MAX_CLIENTS], numdue;
+	int i, j, k, interval, budget, spent, cost;
+	unsigned int start;
+	qboolean overloaded;
+
+	numdue = 0;
+	for( i = 0; i < level.maxclients; i++ ) {
+		bs = botstates[i];
+		if( !bs || !bs->inuse ) {
+			continue;
+		}
+		if (bs->thinkscale < 1) bs->thinkscale = 1;
+		//
+		bs->botthink_residual += elapsed_time;
+		//
+		interval = thinktime * bs->thinkscale;
+		if ( bs->botthink_residual >= interval ) {
+			//insertion sort on how far past the interval the bot is
+			k = bs->botthink_residual - interval;
+			for (j = numdue; j > 0 && overdue[j - 1] < k; j--) {
+				due[j] = due[j - 1];
+				overdue[j] = overdue[j - 1];
+			}
+			due[j] = i;
+			overdue[j] = k;
+			numdue++;
+		}
+	}
+	//
+	budget = bot_thinkbudget.integer;
+	overloaded = budget > 0 && lastoverload && level.time >= lastoverload && level.time - lastoverload < BOT_OVERLOAD_TIME;
+	spent = 0;
+	for (k = 0; k < numdue; k++) {
+		bs = botstates[due[k]];
+		//always let one through so nobody starves
+		if (budget > 0 && k > 0 && spent >= budget) {
+			bs->thinkdeferred++;
+			lastoverload = level.time;
+			continue;
+		}
+		//
+		interval = thinktime * bs->thinkscale;
+		bs->botthink_residual -= interval;
+		//a bot that waited for the budget doesn't get to catch up
+		if (bs->botthink_residual >= interval) bs->botthink_residual %= interval;
+
+		if (!trap_AAS_Initialized()) return qfalse;
+
+		if (g_entities[due[k]].client->pers.connected == CON_CONNECTED) {
+			start = G_ProfileClock();
+			BotAI(due[k], (float) interval / 1000);
+			cost = G_ProfileClock() - start;
+			spent += cost;
+			bs->thinkcount++;
+			bs->thinkusec += cost;
+			if (cost > bs->thinkmaxusec) bs->thinkmaxusec = cost;
+		}
+		//
+		if (overloaded && BotFarFromHumans(bs)) {
+			if (bs->thinkscale < BOT_MAX_THINK_SCALE) bs->thinkscale++;
+		}
+		else if (bs->thinkscale > 1) {
+			bs->thinkscale--;
+		}
+	}
+	return qtrue;
+}
+
 /*
 ==================
 BotAIStartFrame
@@ -1398,6 +1627,9 @@ int BotAIStartFrame(int time) {
 	static int botlib_residual;
 	static int lastbotthink_time;
 	static qboolean skip[MAX_GENTITIES], *s;
+	static int linked[MAX_GENTITIES];
+	static int numLinked = -1;
+	int j, num;
 
 	G_CheckBotSpawn();
 
@@ -1407,6 +1639,7 @@ int BotAIStartFrame(int time) {
 	trap_Cvar_Update(&bot_nochat);
 	trap_Cvar_Update(&bot_testrchat);
 	trap_Cvar_Update(&bot_thinktime);
+	trap_Cvar_Update(&bot_thinkbudget);
 	trap_Cvar_Update(&bot_memorydump);
 	trap_Cvar_Update(&bot_saveroutingcache);
 	trap_Cvar_Update(&bot_pause);
@@ -1416,6 +1649,10 @@ int BotAIStartFrame(int time) {
 //		BotTeamplayReport();
 //		trap_Cvar_Set("bot_report", "0");
 		BotUpdateInfoConfigStrings();
+		BotAIPrintReport();
+	}
+	else {
+		BotAIClearReport();
 	}
 
 	if (bot_pause.integer) {
@@ -1473,15 +1710,35 @@ int BotAIStartFrame(int time) {
 
 		if (!trap_AAS_Initialized()) return qfalse;
 
+		//remove entities that have been freed since the last update
+		if ( numLinked < 0 ) {
+			// first update, clear whatever the botlib may still hold
+			for ( i = 0; i < level.num_entities; i++ ) {
+				if ( !g_entities[i].inuse ) {
+					skip[i] = qtrue;
+					trap_BotLibUpdateEntity( i, NULL );
+				}
+			}
+		}
+		for ( j = 0; j < numLinked; j++ ) {
+			num = linked[j];
+			if ( !skip[num] && !g_entities[num].inuse ) {
+				skip[num] = qtrue;
+				trap_BotLibUpdateEntity( num, NULL );
+				botAIStats.entRemovals++;
+			}
+		}
+		numLinked = 0;
+
 		//update entities in the botlib
-		s = skip;
-		ent = g_entities;
-		for ( i = 0; i < level.num_entities; i++, s++, ent++ ) {
-			ent = &g_entities[i];
-			if ( !ent->inuse || !ent->r.linked || ent->r.svFlags & SVF_NOCLIENT ) {
+		for ( ent = G_NextActiveEntity( NULL ); ent; ent = G_NextActiveEntity( ent ) ) {
+			i = ent - g_entities;
+			s = &skip[i];
+			if ( !ent->r.linked || ent->r.svFlags & SVF_NOCLIENT ) {
 				if ( *s == qfalse ) {
 					*s = qtrue;
 					trap_BotLibUpdateEntity( i, NULL );
+					botAIStats.entRemovals++;
 				}
 				continue;
 			}
@@ -1490,6 +1747,7 @@ int BotAIStartFrame(int time) {
 				if ( *s == qfalse ) {
 					*s = qtrue;
 					trap_BotLibUpdateEntity( i, NULL );
+					botAIStats.entRemovals++;
 				}
 				continue;
 			}
@@ -1498,6 +1756,7 @@ int BotAIStartFrame(int time) {
 				if ( *s == qfalse ) {
 					*s = qtrue;
 					trap_BotLibUpdateEntity( i, NULL );
+					botAIStats.entRemovals++;
 				}
 				continue;
 			}
@@ -1505,7 +1764,11 @@ int BotAIStartFrame(int time) {
 			// never link prox mine triggers
 			if (ent->r.contents == CONTENTS_TRIGGER) {
 				if (ent->touch == ProximityMine_Trigger) {
-					trap_BotLibUpdateEntity(i, NULL);
+					if ( *s == qfalse ) {
+						*s = qtrue;
+						trap_BotLibUpdateEntity( i, NULL );
+						botAIStats.entRemovals++;
+					}
 					continue;
 				}
 			}
@@ -1538,7 +1801,9 @@ int BotAIStartFrame(int time) {
 			state.weapon = ent->s.weapon;
 			//
 			*s = qfalse;
+			linked[ numLinked++ ] = i;
 			trap_BotLibUpdateEntity( i, &state );
+			botAIStats.entUpdates++;
 		}
 
 		BotAIRegularUpdate();
@@ -1547,24 +1812,7 @@ int BotAIStartFrame(int time) {
 	floattime = trap_AAS_Time();
 
 	// execute scheduled bot AI
-	for( i = 0; i < level.maxclients; i++ ) {
-		if( !botstates[i] || !botstates[i]->inuse ) {
-			continue;
-		}
-		//
-		botstates[i]->botthink_residual += elapsed_time;
-		//
-		if ( botstates[i]->botthink_residual >= thinktime ) {
-			botstates[i]->botthink_residual -= thinktime;
-
-			if (!trap_AAS_Initialized()) return qfalse;
-
-			if (g_entities[i].client->pers.connected == CON_CONNECTED) {
-				BotAI(i, (float) thinktime / 1000);
-			}
-		}
-	}
-
+	if (!BotRunThinks(elapsed_time, thinktime)) return qfalse;
 
 	// execute bot user commands every frame
 	for( i = 0; i < level.maxclients; i++ ) {
@@ -1692,6 +1940,7 @@ int BotAISetup( int restart ) {
 	int			errnum;
 
 	trap_Cvar_Register(&bot_thinktime, "bot_thinktime", "100", CVAR_CHEAT);
+	trap_Cvar_Register(&bot_thinkbudget, "bot_thinkbudget", "0", 0);
 	trap_Cvar_Register(&bot_memorydump, "bot_memorydump", "0", CVAR_CHEAT);
 	trap_Cvar_Register(&bot_saveroutingcache, "bot_saveroutingcache", "0", CVAR_CHEAT);
 	trap_Cvar_Register(&bot_pause, "bot_pause", "0", CVAR_CHEAT);
@@ -103,6 +103,11 @@ typedef struct bot_state_s
 {
 	int inuse;										//true if this state is used by a bot client
 	int botthink_residual;							//residual for the bot thinks
+	int thinkscale;									//bot_thinktime multiplier, raised far from humans under load
+	int thinkcount;									//thinks since the last bot_report
+	int thinkusec;									//microseconds spent in them
+	int thinkmaxusec;								//most expensive one
+	int thinkdeferred;								//thinks pushed to a later frame by bot_thinkbudget
 	int client;										//client number of the bot
 	int entitynum;									//entity number of the bot
 	playerState_t cur_ps;							//current player state
@@ -277,3 +282,25 @@ int		BotAI_GetClientState( int clientNum, playerState_t *state );
 qboolean BotAI_GetEntityState( int entityNum, entityState_t *state );
 int		BotAI_GetSnapshotEntity( int clientNum, int sequence, entityState_t *state );
 int		BotTeamLeader(bot_state_t *bs);
+
+//think scheduling, see BotRunThinks
+#define BOT_FAR_FROM_HUMANS		2048	//bots this far from every human think less often under load
+#define BOT_MAX_THINK_SCALE		3
+#define BOT_OVERLOAD_TIME		1000	//msec a deferred think keeps counting as load
+
+//ai cache counters, printed and cleared every BOT_REPORT_TIME while bot_report is set
+#define BOT_REPORT_TIME		10000
+
+typedef struct botaistats_s
+{
+	int visLookups;				//BotEntityVisible calls that got past the fov check
+	int visHits;				//answered from the visibility cache
+	int visTraces;				//traces done by BotEntityVisible
+	int visTracesSaved;			//traces the hits would have done
+	int entUpdates;				//trap_BotLibUpdateEntity calls with a state
+	int entRemovals;			//and without, for entities the botlib should drop
+	int travelLookups;			//BotCachedTravelTime calls
+	int travelHits;				//answered from the travel time cache
+} botaistats_t;
+
+extern botaistats_t botAIStats;
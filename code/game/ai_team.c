@@ -64,15 +64,13 @@ BotNumTeamMates
 */
 int BotNumTeamMates(bot_state_t *bs) {
 	int i, numplayers;
-	char buf[MAX_INFO_STRING];
 
 	numplayers = 0;
 	for (i = 0; i < level.maxclients; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
 		//if no config string or no name
-		if (!buf[0] || !*Info_ValueForKey(buf, "n")) continue;
+		if (!level.playerInfo[i].valid) continue;
 		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		if (level.playerInfo[i].team == TEAM_SPECTATOR) continue;
 		//
 		if (BotSameTeam(bs, i)) {
 			numplayers++;
@@ -93,7 +91,7 @@ int BotClientTravelTimeToGoal(int client, bot_goal_t *goal) {
 	BotAI_GetClientState(client, &ps);
 	areanum = BotPointAreaNum(ps.origin);
 	if (!areanum) return 1;
-	return trap_AAS_AreaTravelTimeToGoalArea(areanum, ps.origin, goal->areanum, TFL_DEFAULT);
+	return BotCachedTravelTime(areanum, ps.origin, goal->areanum, TFL_DEFAULT);
 }
 
 /*
@@ -104,7 +102,6 @@ BotSortTeamMatesByBaseTravelTime
 int BotSortTeamMatesByBaseTravelTime(bot_state_t *bs, int *teammates, int maxteammates) {
 
 	int i, j, k, numteammates, traveltime;
-	char buf[MAX_INFO_STRING];
 	int traveltimes[MAX_CLIENTS];
 	bot_goal_t *goal = NULL;
 
@@ -130,11 +127,10 @@ int BotSortTeamMatesByBaseTravelTime(bot_state_t *bs, int *teammates, int maxtea
 
 	numteammates = 0;
 	for (i = 0; i < level.maxclients; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
 		//if no config string or no name
-		if (!buf[0] || !*Info_ValueForKey(buf, "n")) continue;
+		if (!level.playerInfo[i].valid) continue;
 		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		if (level.playerInfo[i].team == TEAM_SPECTATOR) continue;
 		//
 		if (BotSameTeam(bs, i) && goal) {
 			//
@@ -949,15 +945,13 @@ BotTeamOrders
 void BotTeamOrders(bot_state_t *bs) {
 	int teammates[MAX_CLIENTS];
 	int numteammates, i;
-	char buf[MAX_INFO_STRING];
 
 	numteammates = 0;
 	for (i = 0; i < level.maxclients; i++) {
-		trap_GetConfigstring(CS_PLAYERS+i, buf, sizeof(buf));
 		//if no config string or no name
-		if (!buf[0] || !*Info_ValueForKey(buf, "n")) continue;
+		if (!level.playerInfo[i].valid) continue;
 		//skip spectators
-		if (atoi(Info_ValueForKey(buf, "t")) == TEAM_SPECTATOR) continue;
+		if (level.playerInfo[i].team == TEAM_SPECTATOR) continue;
 		//
 		if (BotSameTeam(bs, i)) {
 			teammates[numteammates] = i;
@@ -903,47 +903,180 @@ Only in One Flag CTF games
 int		bg_numItems = ARRAY_LEN( bg_itemlist ) - 1;
 
 
+/*
+==============================================================================
+
+item lookup
+
+The lookups by classname, pickup name and tag are answered from index
+tables built from bg_itemlist the first time any of them is used, instead
+of walking the whole list.  The name tables are sorted for a binary
+search, and equal names keep their list order so the first matching item
+still wins the way it did with the walk.
+
+==============================================================================
+*/
+
+static qboolean	bg_itemIndexBuilt;
+static int		bg_itemsByClassname[ ARRAY_LEN( bg_itemlist ) ];
+static int		bg_itemsByPickupName[ ARRAY_LEN( bg_itemlist ) ];
+static int		bg_powerupItems[ PW_NUM_POWERUPS ];		// 0 if there is none
+static int		bg_holdableItems[ HI_NUM_HOLDABLE ];
+static int		bg_weaponItems[ WP_NUM_WEAPONS ];
+
+
+static int QDECL BG_CompareItemClassnames( const void *a, const void *b ) {
+	int ia, ib, c;
+
+	ia = *(const int *)a;
+	ib = *(const int *)b;
+	c = strcmp( bg_itemlist[ ia ].classname, bg_itemlist[ ib ].classname );
+
+	return c ? c : ia - ib;
+}
+
+
+static int QDECL BG_CompareItemPickupNames( const void *a, const void *b ) {
+	int ia, ib, c;
+
+	ia = *(const int *)a;
+	ib = *(const int *)b;
+	c = Q_stricmp( bg_itemlist[ ia ].pickup_name, bg_itemlist[ ib ].pickup_name );
+
+	return c ? c : ia - ib;
+}
+
+
 /*
 ==============
-BG_FindItemForPowerup
+BG_BuildItemIndex
 ==============
 */
-gitem_t	*BG_FindItemForPowerup( powerup_t pw ) {
-	int		i;
+static void BG_BuildItemIndex( void ) {
+	gitem_t	*it;
+	int		i, numNamed;
+
+	memset( bg_powerupItems, 0, sizeof( bg_powerupItems ) );
+	memset( bg_holdableItems, 0, sizeof( bg_holdableItems ) );
+	memset( bg_weaponItems, 0, sizeof( bg_weaponItems ) );
+
+	numNamed = 0;
+	for ( i = 1 ; i < bg_numItems ; i++ ) {
+		it = &bg_itemlist[i];
+		bg_itemsByClassname[ numNamed ] = i;
+		bg_itemsByPickupName[ numNamed ] = i;
+		numNamed++;
 
-	for ( i = 0 ; i < bg_numItems ; i++ ) {
-		if ( (bg_itemlist[i].giType == IT_POWERUP || 
-					bg_itemlist[i].giType == IT_TEAM ||
-					bg_itemlist[i].giType == IT_PERSISTANT_POWERUP) && 
-			bg_itemlist[i].giTag == pw ) {
-			return &bg_itemlist[i];
+		if ( it->giTag < 0 ) {
+			continue;
+		}
+		switch ( it->giType ) {
+		case IT_POWERUP:
+		case IT_TEAM:
+		case IT_PERSISTANT_POWERUP:
+			if ( it->giTag < PW_NUM_POWERUPS && !bg_powerupItems[ it->giTag ] ) {
+				bg_powerupItems[ it->giTag ] = i;
+			}
+			break;
+		case IT_HOLDABLE:
+			if ( it->giTag < HI_NUM_HOLDABLE && !bg_holdableItems[ it->giTag ] ) {
+				bg_holdableItems[ it->giTag ] = i;
+			}
+			break;
+		case IT_WEAPON:
+			if ( it->giTag < WP_NUM_WEAPONS && !bg_weaponItems[ it->giTag ] ) {
+				bg_weaponItems[ it->giTag ] = i;
+			}
+			break;
+		default:
+			break;
 		}
 	}
 
-	return NULL;
+	qsort( bg_itemsByClassname, numNamed, sizeof( bg_itemsByClassname[0] ), BG_CompareItemClassnames );
+	qsort( bg_itemsByPickupName, numNamed, sizeof( bg_itemsByPickupName[0] ), BG_CompareItemPickupNames );
+
+	bg_itemIndexBuilt = qtrue;
 }
 
 
 /*
 ==============
-BG_FindItemForHoldable
+BG_SearchItems
+
+Returns the first item in list order with the name, or NULL
 ==============
 */
-gitem_t	*BG_FindItemForHoldable( holdable_t pw ) {
-	int		i;
+static gitem_t *BG_SearchItems( const int *sorted, const char *name, qboolean pickupName ) {
+	const gitem_t	*it;
+	int				low, high, mid, c;
 
-	for ( i = 0 ; i < bg_numItems ; i++ ) {
-		if ( bg_itemlist[i].giType == IT_HOLDABLE && bg_itemlist[i].giTag == pw ) {
-			return &bg_itemlist[i];
+	if ( !name ) {
+		return NULL;
+	}
+
+	low = 0;
+	high = bg_numItems - 1;
+	while ( low < high ) {
+		mid = ( low + high ) >> 1;
+		it = &bg_itemlist[ sorted[ mid ] ];
+		c = pickupName ? Q_stricmp( it->pickup_name, name ) : strcmp( it->classname, name );
+		if ( c < 0 ) {
+			low = mid + 1;
+		} else {
+			high = mid;
 		}
 	}
 
-	Com_Error( ERR_DROP, "HoldableItem not found" );
+	if ( low < bg_numItems - 1 ) {
+		it = &bg_itemlist[ sorted[ low ] ];
+		c = pickupName ? Q_stricmp( it->pickup_name, name ) : strcmp( it->classname, name );
+		if ( !c ) {
+			return &bg_itemlist[ sorted[ low ] ];
+		}
+	}
 
 	return NULL;
 }
 
 
+/*
+==============
+BG_FindItemForPowerup
+==============
+*/
+gitem_t	*BG_FindItemForPowerup( powerup_t pw ) {
+	if ( !bg_itemIndexBuilt ) {
+		BG_BuildItemIndex();
+	}
+
+	if ( (unsigned)pw >= PW_NUM_POWERUPS || !bg_powerupItems[ pw ] ) {
+		return NULL;
+	}
+
+	return &bg_itemlist[ bg_powerupItems[ pw ] ];
+}
+
+
+/*
+==============
+BG_FindItemForHoldable
+==============
+*/
+gitem_t	*BG_FindItemForHoldable( holdable_t pw ) {
+	if ( !bg_itemIndexBuilt ) {
+		BG_BuildItemIndex();
+	}
+
+	if ( (unsigned)pw >= HI_NUM_HOLDABLE || !bg_holdableItems[ pw ] ) {
+		Com_Error( ERR_DROP, "HoldableItem not found" );
+		return NULL;
+	}
+
+	return &bg_itemlist[ bg_holdableItems[ pw ] ];
+}
+
+
 /*
 ===============
 BG_FindItemForWeapon
@@ -951,16 +1084,16 @@ BG_FindItemForWeapon
 ===============
 */
 gitem_t	*BG_FindItemForWeapon( weapon_t weapon ) {
-	gitem_t	*it;
-	
-	for ( it = bg_itemlist + 1 ; it->classname ; it++) {
-		if ( it->giType == IT_WEAPON && it->giTag == weapon ) {
-			return it;
-		}
+	if ( !bg_itemIndexBuilt ) {
+		BG_BuildItemIndex();
 	}
 
-	Com_Error( ERR_DROP, "Couldn't find item for weapon %i", weapon);
-	return NULL;
+	if ( (unsigned)weapon >= WP_NUM_WEAPONS || !bg_weaponItems[ weapon ] ) {
+		Com_Error( ERR_DROP, "Couldn't find item for weapon %i", weapon);
+		return NULL;
+	}
+
+	return &bg_itemlist[ bg_weaponItems[ weapon ] ];
 }
 
 /*
@@ -970,14 +1103,25 @@ BG_FindItem
 ===============
 */
 gitem_t	*BG_FindItem( const char *pickupName ) {
-	gitem_t	*it;
-	
-	for ( it = bg_itemlist + 1 ; it->classname ; it++ ) {
-		if ( !Q_stricmp( it->pickup_name, pickupName ) )
-			return it;
+	if ( !bg_itemIndexBuilt ) {
+		BG_BuildItemIndex();
 	}
 
-	return NULL;
+	return BG_SearchItems( bg_itemsByPickupName, pickupName, qtrue );
+}
+
+/*
+===============
+BG_FindItemByClassname
+
+===============
+*/
+gitem_t	*BG_FindItemByClassname( const char *classname ) {
+	if ( !bg_itemIndexBuilt ) {
+		BG_BuildItemIndex();
+	}
+
+	return BG_SearchItems( bg_itemsByClassname, classname, qfalse );
 }
 
 /*
@@ -233,7 +233,7 @@ void	G_TouchTriggers( gentity_t *ent ) {
 	VectorSubtract( ent->client->ps.origin, range, mins );
 	VectorAdd( ent->client->ps.origin, range, maxs );
 
-	num = trap_EntitiesInBox( mins, maxs, touch, MAX_GENTITIES );
+	num = G_TriggersInBox( mins, maxs, touch, MAX_GENTITIES );
 
 	// can't use ent->absmin, because that has a one unit pad
 	VectorAdd( ent->client->ps.origin, ent->r.mins, mins );
@@ -868,7 +868,7 @@ void ClientThink_real( gentity_t *ent ) {
 			// expand
 			VectorCopy (mins, ent->r.mins);
 			VectorCopy (maxs, ent->r.maxs);
-			trap_LinkEntity(ent);
+			G_LinkEntity(ent);
 			// check if this would get anyone stuck in this player
 			if ( !StuckInOtherClient(ent) ) {
 				// set flag so the expanded size will be set in PM_CheckDuck
@@ -877,7 +877,7 @@ void ClientThink_real( gentity_t *ent ) {
 			// set back
 			VectorCopy (oldmins, ent->r.mins);
 			VectorCopy (oldmaxs, ent->r.maxs);
-			trap_LinkEntity(ent);
+			G_LinkEntity(ent);
 		}
 	}
 #endif
@@ -946,7 +946,7 @@ void ClientThink_real( gentity_t *ent ) {
 	ClientEvents( ent, oldEventSequence );
 
 	// link entity now, after any personal teleporters have been used
-	trap_LinkEntity (ent);
+	G_LinkEntity (ent);
 	if ( !ent->client->noclip ) {
 		G_TouchTriggers( ent );
 	}
@@ -1003,9 +1003,11 @@ A new command has arrived from the client
 */
 void ClientThink( int clientNum ) {
 	gentity_t *ent;
+	unsigned int start;
 
 	ent = g_entities + clientNum;
 	trap_GetUsercmd( clientNum, &ent->client->pers.cmd );
+	G_RecordUsercmd( clientNum, &ent->client->pers.cmd );
 
 	// mark the time we got info, so we can display the
 	// phone jack if they don't get any for a while
@@ -1014,17 +1016,23 @@ void ClientThink( int clientNum ) {
 #endif
 
 	if ( !(ent->r.svFlags & SVF_BOT) && !g_synchronousClients.integer ) {
+		start = G_ProfileBegin();
 		ClientThink_real( ent );
+		G_ProfileEnd( PROF_CLIENT_THINK, start );
 	}
 }
 
 
 void G_RunClient( gentity_t *ent ) {
+	unsigned int start;
+
 	if ( !(ent->r.svFlags & SVF_BOT) && !g_synchronousClients.integer ) {
 		return;
 	}
 	ent->client->pers.cmd.serverTime = level.time;
+	start = G_ProfileBegin();
 	ClientThink_real( ent );
+	G_ProfileEnd( PROF_CLIENT_THINK, start );
 }
 
 
@@ -171,7 +171,7 @@ static gentity_t *SpawnModelOnVictoryPad( gentity_t *pad, vec3_t offset, gentity
 
 	G_SetOrigin( body, vec );
 
-	trap_LinkEntity (body);
+	G_LinkEntity (body);
 
 	body->count = place;
 
@@ -195,7 +195,7 @@ static void CelebrateStop( gentity_t *player ) {
 #define	TIMER_GESTURE	(34*66+50)
 static void CelebrateStart( gentity_t *player ) {
 	player->s.torsoAnim = ( ( player->s.torsoAnim & ANIM_TOGGLEBIT ) ^ ANIM_TOGGLEBIT ) | TORSO_GESTURE;
-	player->nextthink = level.time + TIMER_GESTURE;
+	G_SetNextThink( player, level.time + TIMER_GESTURE );
 	player->think = CelebrateStop;
 
 	/*
@@ -216,7 +216,7 @@ static void PodiumPlacementThink( gentity_t *podium ) {
 	vec3_t		origin;
 	vec3_t		f, r, u;
 
-	podium->nextthink = level.time + 100;
+	G_SetNextThink( podium, level.time + 100 );
 
 	AngleVectors( level.intermission_angle, vec, NULL, NULL );
 	VectorMA( level.intermission_origin, trap_Cvar_VariableIntegerValue( "g_podiumDist" ), vec, origin );
@@ -291,10 +291,10 @@ static gentity_t *SpawnPodium( void ) {
 
 	VectorSubtract( level.intermission_origin, podium->r.currentOrigin, vec );
 	podium->s.apos.trBase[YAW] = vectoyaw( vec );
-	trap_LinkEntity (podium);
+	G_LinkEntity (podium);
 
 	podium->think = PodiumPlacementThink;
-	podium->nextthink = level.time + 100;
+	G_SetNextThink( podium, level.time + 100 );
 	return podium;
 }
 
@@ -317,7 +317,7 @@ void SpawnModelsOnVictoryPads( void ) {
 	player = SpawnModelOnVictoryPad( podium, offsetFirst, &g_entities[level.sortedClients[0]],
 				level.clients[ level.sortedClients[0] ].ps.persistant[PERS_RANK] &~ RANK_TIED_FLAG );
 	if ( player ) {
-		player->nextthink = level.time + 2000;
+		G_SetNextThink( player, level.time + 2000 );
 		player->think = CelebrateStart;
 		podium1 = player;
 	}
@@ -349,7 +349,7 @@ void Svcmd_AbortPodium_f( void ) {
 	}
 
 	if( podium1 ) {
-		podium1->nextthink = level.time;
+		G_SetNextThink( podium1, level.time );
 		podium1->think = CelebrateStop;
 	}
 }
@@ -677,6 +677,7 @@ static void G_AddBot( const char *name, float skill, const char *team, int delay
 	bot = &g_entities[ clientNum ];
 	bot->r.svFlags |= SVF_BOT;
 	bot->inuse = qtrue;
+	G_AddActiveEntity( bot );
 
 	// register the userinfo
 	trap_SetUserinfo( clientNum, userinfo );
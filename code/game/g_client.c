@@ -294,7 +294,7 @@ void BodySink( gentity_t *ent ) {
 		ent->physicsObject = qfalse;
 		return;	
 	}
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( ent, level.time + FRAMETIME );
 	ent->s.pos.trBase[2] -= 1;
 }
 
@@ -392,7 +392,7 @@ void CopyToBodyQue( gentity_t *ent ) {
 	body->r.contents = CONTENTS_CORPSE;
 	body->r.ownerNum = ent->s.number;
 
-	body->nextthink = level.time + 5000;
+	G_SetNextThink( body, level.time + 5000 );
 	body->think = BodySink;
 
 	body->die = body_die;
@@ -402,10 +402,11 @@ void CopyToBodyQue( gentity_t *ent ) {
 		body->takedamage = qfalse;
 	} else {
 		body->takedamage = qtrue;
+		G_AddDamageable( body );
 	}
 
 	VectorCopy ( body->s.pos.trBase, body->r.currentOrigin );
-	trap_LinkEntity( body );
+	G_LinkEntity( body );
 }
 
 
@@ -564,6 +565,32 @@ team_t PickTeam( int ignoreClientNum ) {
 }
 
 
+/*
+===========
+G_SetPlayerInfo
+
+Mirrors what goes into the CS_PLAYERS configstring of a client into
+level.playerInfo, a NULL name clears it
+============
+*/
+static void G_SetPlayerInfo( int clientNum, const char *name, team_t team, const char *model ) {
+	playerInfo_t *pi;
+
+	pi = &level.playerInfo[ clientNum ];
+	memset( pi, 0, sizeof( *pi ) );
+	if ( !name ) {
+		return;
+	}
+
+	pi->valid = qtrue;
+	pi->team = team;
+	Q_strncpyz( pi->name, name, sizeof( pi->name ) );
+	Q_strncpyz( pi->cleanname, name, sizeof( pi->cleanname ) );
+	Q_CleanStr( pi->cleanname );
+	Q_strncpyz( pi->model, model, sizeof( pi->model ) );
+}
+
+
 /*
 ===========
 ClientUserInfoChanged
@@ -709,6 +736,7 @@ qboolean ClientUserinfoChanged( int clientNum ) {
 	}
 
 	trap_SetConfigstring( CS_PLAYERS+clientNum, s );
+	G_SetPlayerInfo( clientNum, client->pers.netname, client->sess.sessionTeam, model );
 
 	// this is not the userinfo, more like the configstring actually
 	G_LogPrintf( "ClientUserinfoChanged: %i %s\n", clientNum, s );
@@ -771,6 +799,7 @@ const char *ClientConnect( int clientNum, qboolean firstTime, qboolean isBot ) {
 
 	ent->r.svFlags &= ~SVF_BOT;
 	ent->inuse = qfalse;
+	G_RemoveActiveEntity( ent );
 
 	trap_GetUserinfo( clientNum, userinfo, sizeof( userinfo ) );
 
@@ -831,11 +860,13 @@ const char *ClientConnect( int clientNum, qboolean firstTime, qboolean isBot ) {
 		client->sess.spectatorClient = clientNum;
 	}
 	ent->inuse = qtrue;
+	G_AddActiveEntity( ent );
 
 	// get and distribute relevant paramters
 	G_LogPrintf( "ClientConnect: %i\n", clientNum );
 
 	client->pers.connected = CON_CONNECTING;
+	G_RankClient( clientNum );
 
 	ClientUserinfoChanged( clientNum );
 
@@ -894,6 +925,7 @@ void ClientBegin( int clientNum ) {
 		return;
 
 	client->pers.connected = CON_CONNECTED;
+	G_RankClient( clientNum );
 	client->pers.enterTime = level.time;
 	client->pers.teamState.state = TEAM_BEGIN;
 	spawns = client->ps.persistant[PERS_SPAWN_COUNT];
@@ -1015,10 +1047,6 @@ void ClientSpawn(gentity_t *ent) {
 	flags = client->ps.eFlags & (EF_TELEPORT_BIT | EF_VOTED | EF_TEAMVOTED);
 	flags ^= EF_TELEPORT_BIT;
 
-	// unlagged
-	G_ResetHistory( ent );
-	client->saved.leveltime = 0;
-
 	// clear everything but the persistant data
 
 	saved = client->pers;
@@ -1065,6 +1093,7 @@ void ClientSpawn(gentity_t *ent) {
 	ent->s.groundEntityNum = ENTITYNUM_NONE;
 	ent->client = &level.clients[index];
 	ent->inuse = qtrue;
+	G_AddActiveEntity( ent );
 	ent->classname = "player";
 	if ( isSpectator ) {
 		ent->takedamage = qfalse;
@@ -1073,6 +1102,7 @@ void ClientSpawn(gentity_t *ent) {
 		client->ps.pm_type = PM_SPECTATOR;
 	} else {
 		ent->takedamage = qtrue;
+		G_AddDamageable( ent );
 		ent->r.contents = CONTENTS_BODY;
 		ent->clipmask = MASK_PLAYERSOLID;
 	}
@@ -1103,6 +1133,9 @@ void ClientSpawn(gentity_t *ent) {
 	G_SetOrigin( ent, spawn_origin );
 	VectorCopy( spawn_origin, client->ps.origin );
 
+	// unlagged
+	G_ResetHistory( ent );
+
 	// the respawned flag will be cleared after the attack and jump keys come up
 	client->ps.pm_flags |= PMF_RESPAWNED;
 
@@ -1133,7 +1166,7 @@ void ClientSpawn(gentity_t *ent) {
 		MoveClientToIntermission( ent );
 	} else {
 		if ( !isSpectator )
-			trap_LinkEntity( ent );
+			G_LinkEntity( ent );
 		// fire the targets of the spawn point
 		G_UseTargets( spawnPoint, ent );
 
@@ -1233,12 +1266,15 @@ void ClientDisconnect( int clientNum ) {
 	trap_UnlinkEntity( ent );
 	ent->s.modelindex = 0;
 	ent->inuse = qfalse;
+	G_RemoveActiveEntity( ent );
 	ent->classname = "disconnected";
 	ent->client->pers.connected = CON_DISCONNECTED;
 	ent->client->ps.persistant[PERS_TEAM] = TEAM_FREE;
 	ent->client->sess.sessionTeam = TEAM_FREE;
+	G_RankClient( clientNum );
 
 	trap_SetConfigstring( CS_PLAYERS + clientNum, "" );
+	G_SetPlayerInfo( clientNum, NULL, TEAM_FREE, NULL );
 
 	G_ClearClientSessionData( ent->client );
 
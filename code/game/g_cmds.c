@@ -8,11 +8,14 @@
 
 /*
 ==================
-DeathmatchScoreboardMessage
+G_BuildScoreboardMessage
 
+The scores are the same for every client, so the message is built once
+and sent to everybody who asks for it until the next frame or until
+G_InvalidateScoreboard is called
 ==================
 */
-void DeathmatchScoreboardMessage( gentity_t *ent ) {
+static void G_BuildScoreboardMessage( void ) {
 	char		entry[256]; // enough to hold 14 integers
 	char		string[MAX_STRING_CHARS-1];
 	int			stringlength;
@@ -71,9 +74,39 @@ void DeathmatchScoreboardMessage( gentity_t *ent ) {
 		stringlength += j;
 	}
 
-	trap_SendServerCommand( ent-g_entities, va( "scores %i %i %i%s", i,
+	BG_sprintf( level.scoreboardMessage, "scores %i %i %i%s", i,
 		level.teamScores[TEAM_RED], level.teamScores[TEAM_BLUE],
-		string ) );
+		string );
+
+	level.scoreboardTime = level.time;
+	level.scoreboardValid = qtrue;
+}
+
+
+/*
+==================
+G_InvalidateScoreboard
+
+Scores, ranks or team scores changed within the frame
+==================
+*/
+void G_InvalidateScoreboard( void ) {
+	level.scoreboardValid = qfalse;
+}
+
+
+/*
+==================
+DeathmatchScoreboardMessage
+
+==================
+*/
+void DeathmatchScoreboardMessage( gentity_t *ent ) {
+	if ( !level.scoreboardValid || level.scoreboardTime != level.time ) {
+		G_BuildScoreboardMessage();
+	}
+
+	trap_SendServerCommand( ent-g_entities, level.scoreboardMessage );
 }
 
 
@@ -554,6 +587,7 @@ qboolean SetTeam( gentity_t *ent, const char *s ) {
 		if ( team != -1 && AllowTeamSwitch( clientNum, team ) ) {
 			client->sess.sessionTeam = team;
 			client->pers.teamState.state = TEAM_BEGIN;
+			G_RankClient( clientNum );
 			G_WriteClientSessionData( client );
 			// count current clients and rank for scoreboard
 			CalculateRanks();
@@ -663,6 +697,7 @@ qboolean SetTeam( gentity_t *ent, const char *s ) {
 	client->sess.sessionTeam = team;
 	client->sess.spectatorState = specState;
 	client->sess.spectatorClient = specClient;
+	G_RankClient( clientNum );
 
 	checkTeamLeader = client->sess.teamLeader;
 	client->sess.teamLeader = qfalse;
@@ -713,6 +748,7 @@ void StopFollowing( gentity_t *ent, qboolean release ) {
 
 	client->ps.persistant[ PERS_TEAM ] = TEAM_SPECTATOR;	
 	client->sess.sessionTeam = TEAM_SPECTATOR;	
+	G_RankClient( ent - g_entities );
 	if ( release ) {
 		client->ps.stats[STAT_HEALTH] = ent->health = 1;
 		memset( client->ps.powerups, 0, sizeof ( client->ps.powerups ) );
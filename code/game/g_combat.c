@@ -160,7 +160,7 @@ void TossClientCubes( gentity_t *self ) {
 
 	drop = LaunchItem( item, origin, velocity );
 
-	drop->nextthink = level.time + g_cubeTimeout.integer * 1000;
+	G_SetNextThink( drop, level.time + g_cubeTimeout.integer * 1000 );
 	drop->think = G_FreeEntity;
 	drop->spawnflags = self->client->sess.sessionTeam;
 }
@@ -187,7 +187,7 @@ void TossClientPersistantPowerups( gentity_t *ent ) {
 	powerup->r.svFlags &= ~SVF_NOCLIENT;
 	powerup->s.eFlags &= ~EF_NODRAW;
 	powerup->r.contents = CONTENTS_TRIGGER;
-	trap_LinkEntity( powerup );
+	G_LinkEntity( powerup );
 
 	ent->client->ps.stats[STAT_PERSISTANT_POWERUP] = 0;
 	ent->client->persistantPowerup = NULL;
@@ -298,7 +298,7 @@ void Kamikaze_DeathTimer( gentity_t *self ) {
 	VectorCopy(self->s.pos.trBase, ent->s.pos.trBase);
 	ent->r.svFlags |= SVF_NOCLIENT;
 	ent->think = Kamikaze_DeathActivate;
-	ent->nextthink = level.time + 5 * 1000;
+	G_SetNextThink( ent, level.time + 5 * 1000 );
 
 	ent->activator = self;
 }
@@ -424,7 +424,7 @@ void player_die( gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int
 	if ((self->client->ps.eFlags & EF_TICKING) && self->activator) {
 		self->client->ps.eFlags &= ~EF_TICKING;
 		self->activator->think = G_FreeEntity;
-		self->activator->nextthink = level.time;
+		G_SetNextThink( self->activator, level.time );
 	}
 #endif
 	self->client->ps.pm_type = PM_DEAD;
@@ -570,6 +570,7 @@ void player_die( gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int
 	}
 
 	self->takedamage = qtrue;	// can still be gibbed
+	G_AddDamageable( self );
 
 	self->s.weapon = WP_NONE;
 	self->s.powerups = 0;
@@ -657,7 +658,7 @@ void player_die( gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int
 #endif
 	}
 
-	trap_LinkEntity (self);
+	G_LinkEntity (self);
 
 }
 
@@ -1186,8 +1187,11 @@ qboolean G_RadiusDamage ( vec3_t origin, gentity_t *attacker, float damage, floa
 	vec3_t		v;
 	vec3_t		dir;
 	int			i, e;
+	unsigned int	start;
 	qboolean	hitClient = qfalse;
 
+	start = G_ProfileBegin();
+
 	if ( radius < 1 ) {
 		radius = 1;
 	}
@@ -1197,7 +1201,8 @@ qboolean G_RadiusDamage ( vec3_t origin, gentity_t *attacker, float damage, floa
 		maxs[i] = origin[i] + radius;
 	}
 
-	numListedEntities = trap_EntitiesInBox( mins, maxs, entityList, MAX_GENTITIES );
+	numListedEntities = G_DamageablesInBox( mins, maxs, entityList, MAX_GENTITIES );
+	G_ProfileCount( PCOUNT_RADIUS_TARGETS, numListedEntities );
 
 	for ( e = 0 ; e < numListedEntities ; e++ ) {
 		ent = &g_entities[entityList[ e ]];
@@ -1220,11 +1225,13 @@ qboolean G_RadiusDamage ( vec3_t origin, gentity_t *attacker, float damage, floa
 
 		dist = VectorLength( v );
 		if ( dist >= radius ) {
+			G_ProfileCount( PCOUNT_RADIUS_REJECTED, 1 );
 			continue;
 		}
 
 		points = damage * ( 1.0 - dist / radius );
 
+		G_ProfileCount( PCOUNT_RADIUS_CANDAMAGE, 1 );
 		if( CanDamage (ent, origin) ) {
 			if( LogAccuracyHit( ent, attacker ) ) {
 				hitClient = qtrue;
@@ -1237,5 +1244,7 @@ qboolean G_RadiusDamage ( vec3_t origin, gentity_t *attacker, float damage, floa
 		}
 	}
 
+	G_ProfileEnd( PROF_RADIUS_DAMAGE, start );
+
 	return hitClient;
 }
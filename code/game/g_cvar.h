@@ -60,6 +60,9 @@ G_CVAR( g_inactivity, "g_inactivity", "0", 0, 0, qtrue, qfalse )
 G_CVAR( g_debugMove, "g_debugMove", "0", 0, 0, qfalse, qfalse )
 G_CVAR( g_debugDamage, "g_debugDamage", "0", 0, 0, qfalse, qfalse )
 G_CVAR( g_debugAlloc, "g_debugAlloc", "0", 0, 0, qfalse, qfalse )
+G_CVAR( g_levelMemory, "g_levelMemory", "1536", CVAR_LATCH | CVAR_ARCHIVE, 0, qfalse, qfalse )
+G_CVAR( g_persistentMemory, "g_persistentMemory", "640", CVAR_LATCH | CVAR_ARCHIVE, 0, qfalse, qfalse )
+G_CVAR( g_frameMemory, "g_frameMemory", "64", CVAR_LATCH | CVAR_ARCHIVE, 0, qfalse, qfalse )
 G_CVAR( g_motd, "g_motd", "", 0, 0, qfalse, qfalse )
 G_CVAR( g_blood, "com_blood", "1", 0, 0, qfalse, qfalse )
 
@@ -70,6 +73,11 @@ G_CVAR( g_allowVote, "g_allowVote", "1", CVAR_ARCHIVE, 0, qfalse, qfalse )
 G_CVAR( g_listEntity, "g_listEntity", "0", 0, 0, qfalse, qfalse )
 
 G_CVAR( g_unlagged, "g_unlagged", "1", CVAR_SERVERINFO | CVAR_ARCHIVE, 0, qfalse, qfalse )
+G_CVAR( g_unlaggedMaxMs, "g_unlaggedMaxMs", "1000", CVAR_ARCHIVE, 0, qfalse, qfalse )
+G_CVAR( g_unlaggedBroadphase, "g_unlaggedBroadphase", "1", CVAR_ARCHIVE, 0, qfalse, qfalse )
+G_CVAR( g_debugUnlagged, "g_debugUnlagged", "0", 0, 0, qfalse, qfalse )
+G_CVAR( g_profile, "g_profile", "0", 0, 0, qfalse, qfalse )
+G_CVAR( g_recordCmds, "g_recordCmds", "0", 0, 0, qfalse, qfalse )
 G_CVAR( g_predictPVS, "g_predictPVS", "0", CVAR_ARCHIVE, 0, qfalse, qfalse )
 
 #ifdef MISSIONPACK
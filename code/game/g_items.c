@@ -409,7 +409,7 @@ void RespawnItem( gentity_t *ent ) {
 
 		for ( count = 0, ent = master; ent; ent = ent->teamchain, count++ ) {
 			// reset spawn timers on all teamed entities
-			ent->nextthink = 0;
+			G_SetNextThink( ent, 0 );
 		}
 
 		choice = rand() % count;
@@ -425,7 +425,7 @@ void RespawnItem( gentity_t *ent ) {
 	ent->r.contents = CONTENTS_TRIGGER;
 	ent->s.eFlags &= ~EF_NODRAW;
 	ent->r.svFlags &= ~SVF_NOCLIENT;
-	trap_LinkEntity( ent );
+	G_LinkEntity( ent );
 
 	if ( ent->item->giType == IT_POWERUP ) {
 		// play powerup spawn sound to all clients
@@ -461,7 +461,7 @@ void RespawnItem( gentity_t *ent ) {
 	// play the normal respawn sound only to nearby clients
 	G_AddEvent( ent, EV_ITEM_RESPAWN, 0 );
 
-	ent->nextthink = 0;
+	G_SetNextThink( ent, 0 );
 }
 
 
@@ -599,14 +599,14 @@ void Touch_Item (gentity_t *ent, gentity_t *other, trace_t *trace) {
 	// delete it).  This is used by items that are respawned by third party 
 	// events such as ctf flags
 	if ( respawn <= 0 ) {
-		ent->nextthink = 0;
+		G_SetNextThink( ent, 0 );
 		ent->think = 0;
 	} else {
-		ent->nextthink = level.time + respawn;
+		G_SetNextThink( ent, level.time + respawn );
 		ent->think = RespawnItem;
 	}
 
-	trap_LinkEntity( ent );
+	G_LinkEntity( ent );
 }
 
 
@@ -651,16 +651,16 @@ gentity_t *LaunchItem( gitem_t *item, vec3_t origin, vec3_t velocity ) {
 	if (g_gametype.integer == GT_CTF && item->giType == IT_TEAM) { // Special case for CTF flags
 #endif
 		dropped->think = Team_DroppedFlagThink;
-		dropped->nextthink = level.time + 30000;
+		G_SetNextThink( dropped, level.time + 30000 );
 		Team_CheckDroppedItem( dropped );
 	} else { // auto-remove after 30 seconds
 		dropped->think = G_FreeEntity;
-		dropped->nextthink = level.time + 30000;
+		G_SetNextThink( dropped, level.time + 30000 );
 	}
 
 	dropped->flags = FL_DROPPED_ITEM;
 
-	trap_LinkEntity (dropped);
+	G_LinkEntity (dropped);
 
 	return dropped;
 }
@@ -758,7 +758,7 @@ void FinishSpawningItem( gentity_t *ent ) {
 		return;
 	}
 
-	trap_LinkEntity( ent );
+	G_LinkEntity( ent );
 }
 
 
@@ -948,7 +948,7 @@ void G_SpawnItem( gentity_t *ent, gitem_t *item ) {
 	ent->item = item;
 	// some movers spawn on the second frame, so delay item
 	// spawns until the third frame so they can ride trains
-	ent->nextthink = level.time + FRAMETIME * 2;
+	G_SetNextThink( ent, level.time + FRAMETIME * 2 );
 	ent->think = FinishSpawningItem;
 
 	ent->physicsBounce = 0.50;		// items are bouncy
@@ -1045,7 +1045,7 @@ void G_RunItem( gentity_t *ent ) {
 		tr.fraction = 0;
 	}
 
-	trap_LinkEntity( ent );	// FIXME: avoid this for stationary?
+	G_LinkEntity( ent );	// FIXME: avoid this for stationary?
 
 	// check think function
 	G_RunThink( ent );
@@ -99,9 +99,9 @@ struct gentity_s {
 	int			timestamp;		// body queue sinking, etc
 
 	float		angle;			// set in editor, -1 = up, -2 = down
-	const char	*target;
-	const char	*targetname;
-	const char	*team;
+	const char	*target;			// target, targetname and team only ever hold
+	const char	*targetname;		// interned strings, so compare the pointers,
+	const char	*team;				// the first two from G_NewName ignoring case
 	const char	*targetShaderName;
 	const char	*targetShaderNewName;
 	gentity_t	*target_ent;
@@ -185,6 +185,9 @@ typedef struct {
 	playerTeamStateState_t	state;
 
 	int			location;
+	gentity_t	*lastLocation;		// Team_GetLocation cache
+	vec3_t		lastLocationOrigin;
+	qboolean	lastLocationValid;
 
 	int			captures;
 	int			basedefense;
@@ -236,6 +239,8 @@ typedef struct {
 	int			voteCount;			// to prevent people from constantly calling votes
 	int			teamVoteCount;		// to prevent people from constantly calling votes
 	qboolean	teamInfo;			// send team overlay updates?
+	int			teamInfoId;			// last tinfo payload sent
+	int			teamInfoTime;		// and when
 	int			voted;
 	int			teamVoted;
 
@@ -243,13 +248,23 @@ typedef struct {
 } clientPersistant_t;
 
 // unlagged
-#define NUM_CLIENT_HISTORY 18
+#define MAX_CLIENT_HISTORY	128		// g_unlaggedMaxMs 1000 at sv_fps 125
+
+// position records, kept in separate arrays so that the
+// time lookup doesn't drag the vectors through the cache
+typedef struct {
+	int			head;				// most recent record
+	int			leveltime[ MAX_CLIENT_HISTORY ];
+	vec3_t		currentOrigin[ MAX_CLIENT_HISTORY ];
+	vec3_t		mins[ MAX_CLIENT_HISTORY ];
+	vec3_t		maxs[ MAX_CLIENT_HISTORY ];
+} clientHistory_t;
 
 typedef struct {
 	vec3_t		mins, maxs;
 	vec3_t		currentOrigin;
 	int			leveltime;
-} clientHistory_t;
+} clientSavedPosition_t;
 
 // this structure is cleared on each ClientSpawn(),
 // except for 'client->pers' and 'client->sess'
@@ -321,10 +336,9 @@ struct gclient_s {
 	char		*areabits;
 
 	// unlagged
-	clientHistory_t	history[ NUM_CLIENT_HISTORY ];
-	clientHistory_t	saved;
+	clientHistory_t	history;
+	clientSavedPosition_t	saved;
 
-	int			historyHead;
 	int			frameOffset;
 	int			lastUpdateFrame;
 
@@ -343,6 +357,16 @@ struct gclient_s {
 #define	MAX_SPAWN_VARS			64
 #define	MAX_SPAWN_VARS_CHARS	4096
 
+// what the CS_PLAYERS configstring of a client says, kept parsed so
+// the bot code doesn't have to fetch and pick it apart again
+typedef struct {
+	qboolean	valid;				// the configstring is set
+	team_t		team;
+	char		name[MAX_NETNAME];
+	char		cleanname[MAX_NETNAME];	// without color escapes
+	char		model[MAX_QPATH];		// "model/skin"
+} playerInfo_t;
+
 #define NUM_SPAWN_SPOTS MAX_GENTITIES
 #define SPAWN_SPOT_INTERMISSION NUM_SPAWN_SPOTS-1
 
@@ -367,6 +391,9 @@ typedef struct {
 	int			startTime;				// level.time the map was started
 	int			msec;					// current frame duration
 
+	int			frameThinks;			// think functions run this frame
+	int			peakThinks;
+
 	int			teamScores[TEAM_NUM_TEAMS];
 	int			lastTeamLocationTime;		// last time of client team location update
 
@@ -379,6 +406,7 @@ typedef struct {
 	int			numNonSpectatorClients;	// includes connecting clients
 	int			numPlayingClients;		// connected, non-spectators
 	int			sortedClients[MAX_CLIENTS];		// sorted by score
+	int			rankFlags[MAX_CLIENTS];			// what each client adds to the counters above
 	int			follow1, follow2;		// clientNums for auto-follow spectators
 
 	int			snd_fry;				// sound index for standing in lava
@@ -441,6 +469,19 @@ typedef struct {
 
 	// unlagged
 	int			frameStartTime;
+	int			historySize;			// records used in each client history ring
+
+	// cached "scores" command, see DeathmatchScoreboardMessage
+	char		scoreboardMessage[MAX_STRING_CHARS];
+	int			scoreboardTime;			// level.time it was built
+	qboolean	scoreboardValid;
+
+	// last values written to CS_SCORES1/2
+	int			scores1, scores2;
+	qboolean	scoresSent;
+
+	// parsed CS_PLAYERS, see G_SetPlayerInfo
+	playerInfo_t	playerInfo[MAX_CLIENTS];
 
 } level_locals_t;
 
@@ -454,7 +495,8 @@ qboolean	G_SpawnFloat( const char *key, const char *defaultString, float *out );
 qboolean	G_SpawnInt( const char *key, const char *defaultString, int *out );
 qboolean	G_SpawnVector( const char *key, const char *defaultString, float *out );
 void		G_SpawnEntitiesFromString( void );
-char *G_NewString( const char *string );
+const char *G_NewString( const char *string );
+const char *G_NewName( const char *string );
 
 //
 // g_cmds.c
@@ -492,21 +534,37 @@ void SaveRegisteredItems( void );
 //
 // g_utils.c
 //
+void	G_InitConfigstringIndexes( void );
 int		G_ModelIndex( const char *name );
 int		G_SoundIndex( const char *name );
 void	G_TeamCommand( team_t team, const char *cmd );
 void	G_KillBox (gentity_t *ent);
 gentity_t *G_Find (gentity_t *from, int fieldofs, const char *match);
+gentity_t *G_NextTarget( gentity_t *from, const char *targetname );
+gentity_t *G_NextTeamMember( gentity_t *from, const char *team );
+void	G_UpdateEntityNames( gentity_t *ent );
 gentity_t *G_PickTarget (const char *targetname);
 void	G_UseTargets (gentity_t *ent, gentity_t *activator);
 void	G_SetMovedir ( vec3_t angles, vec3_t movedir);
 
+void	G_SetNextThink( gentity_t *ent, int time );
+int		G_PopDueThinks( int *list );
+void	G_InitEntityAlloc( void );
+void	G_AddActiveEntity( gentity_t *ent );
+void	G_RemoveActiveEntity( gentity_t *ent );
+gentity_t *G_NextActiveEntity( gentity_t *from );
+int		G_TriggersInBox( const vec3_t mins, const vec3_t maxs, int *list, int maxcount );
+void	G_LinkEntity( gentity_t *ent );		// use instead of trap_LinkEntity
+void	G_AddDamageable( gentity_t *ent );
+int		G_DamageablesInBox( const vec3_t mins, const vec3_t maxs, int *list, int maxcount );
 void	G_InitGentity( gentity_t *e );
 gentity_t	*G_Spawn (void);
 gentity_t *G_TempEntity( vec3_t origin, int event );
 void	G_Sound( gentity_t *ent, int channel, int soundIndex );
 void	G_FreeEntity( gentity_t *e );
 qboolean	G_EntitiesFree( void );
+void	Svcmd_EntityStats_f( void );
+void	Svcmd_ConfigstringStats_f( void );
 
 void	G_TouchTriggers (gentity_t *ent);
 void	G_TouchSolids (gentity_t *ent);
@@ -611,6 +669,7 @@ void InitBodyQue (void);
 void ClientSpawn( gentity_t *ent );
 void player_die (gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int damage, int mod);
 void AddScore( gentity_t *ent, vec3_t origin, int score );
+void G_RankClient( int clientNum );
 void CalculateRanks( void );
 qboolean SpotWouldTelefrag( gentity_t *spot );
 
@@ -633,6 +692,7 @@ void G_StartKamikaze( gentity_t *ent );
 // g_cmds.c
 //
 void DeathmatchScoreboardMessage( gentity_t *ent );
+void G_InvalidateScoreboard( void );
 
 //
 // g_main.c
@@ -674,7 +734,23 @@ void Team_ResetFlags( void );
 //
 // g_mem.c
 //
+typedef enum {
+	MEM_LEVEL,
+	MEM_PERSISTENT,
+	MEM_FRAME,
+
+	MEM_NUM_ARENAS
+} memArena_t;
+
 void *G_Alloc( size_t size );
+void *G_ArenaAlloc( memArena_t arena, int size );
+const char *G_InternString( const char *string );
+const char *G_FindString( const char *string );
+const char *G_InternName( const char *name );
+const char *G_FindName( const char *name );
+int G_ArenaMark( memArena_t arena );
+void G_ArenaRelease( memArena_t arena, int mark );
+void G_ResetFrameMemory( void );
 void G_InitMemory( void );
 void Svcmd_GameMem_f( void );
 
@@ -700,14 +776,85 @@ void Svcmd_AbortPodium_f( void );
 // g_unlagged.c
 //
 void G_ResetHistory( gentity_t *ent );
+void G_UpdateHistorySize( void );
 void G_StoreHistory( gentity_t *ent );
 void G_TimeShiftAllClients( int time, gentity_t *skip );
+void G_TimeShiftClientsForMissiles( int time, gentity_t **missiles, int numMissiles );
 void G_UnTimeShiftAllClients( gentity_t *skip );
-void G_DoTimeShiftFor( gentity_t *ent );
+void G_DoTimeShiftFor( gentity_t *ent, const vec3_t start, const vec3_t end, float spread );
+void G_WidenTimeShiftFor( gentity_t *ent );
 void G_UndoTimeShiftFor( gentity_t *ent );
 void G_UnTimeShiftClient( gentity_t *client );
 void G_PredictPlayerMove( gentity_t *ent, float frametime );
 
+//
+// g_profile.c
+//
+typedef enum {
+	PROF_FRAME,
+	PROF_ENTITIES,
+	PROF_MISSILES,
+	PROF_CLIENT_END_FRAME,
+	PROF_EXIT_RULES,
+	PROF_TEAM_STATUS,
+	PROF_BOTAI,
+	PROF_CLIENT_THINK,
+	PROF_RADIUS_DAMAGE,
+
+	PROF_NUM_SCOPES
+} profileScopeId_t;
+
+typedef enum {
+	PCOUNT_RADIUS_TARGETS,		// damageable entities in the blast box
+	PCOUNT_RADIUS_REJECTED,		// out of range by their bounds, no CanDamage traces
+	PCOUNT_RADIUS_CANDAMAGE,
+
+	PCOUNT_NUM_COUNTERS
+} profileCounterId_t;
+
+void G_ProfileReset( void );
+unsigned int G_ProfileClock( void );
+unsigned int G_ProfileBegin( void );
+void G_ProfileEnd( profileScopeId_t id, unsigned int start );
+void G_ProfileCount( profileCounterId_t id, int count );
+void Svcmd_Profile_f( void );
+
+//
+// g_record.c
+//
+#define RECORD_MAGIC		(('D'<<24)+('M'<<16)+('C'<<8)+'U')	// "UCMD"
+#define RECORD_VERSION		1
+
+typedef enum {
+	REC_END,
+	REC_SPAWN,
+	REC_FRAME,
+	REC_CONNECT,
+	REC_BEGIN,
+	REC_USERINFO,
+	REC_DISCONNECT,
+	REC_COMMAND,
+	REC_USERCMD,
+	REC_CVAR
+} recordType_t;
+
+// usercmd fields present in a REC_USERCMD record
+#define UCMD_PITCH			1
+#define UCMD_YAW			2
+#define UCMD_ROLL			4
+#define UCMD_BUTTONS		8
+#define UCMD_WEAPON			16
+#define UCMD_MOVE			32
+
+void G_RecordInit( int levelTime, int randomSeed );
+void G_RecordCvar( const char *name );
+void G_RecordShutdown( void );
+void G_RecordSpawnVars( void );
+void G_RecordFrame( int levelTime );
+void G_RecordClient( recordType_t type, int clientNum, int arg0, int arg1 );
+void G_RecordCommand( int clientNum );
+void G_RecordUsercmd( int clientNum, const usercmd_t *cmd );
+
 //
 // g_bot.c
 //
@@ -969,11 +1116,14 @@ void	trap_SnapVector( float *v );
 // extension interface
 
 #ifdef Q3_VM
-//
+extern int (*trap_Microseconds)( void );
 #else
 qboolean trap_GetValue( char *value, int valueSize, const char *key );
+int trap_Microseconds( void );
 extern int dll_com_trapGetValue;
+extern int dll_trap_Microseconds;
 #endif
 
 extern	int svf_self_portal2;
+extern	qboolean hiResClock;
 
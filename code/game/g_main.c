@@ -44,11 +44,14 @@ static void SendScoreboardMessageToAllClients( void );
 // extension interface
 #ifdef Q3_VM
 qboolean (*trap_GetValue)( char *value, int valueSize, const char *key );
+int (*trap_Microseconds)( void );
 #else
 int dll_com_trapGetValue;
+int dll_trap_Microseconds;
 #endif
 
 int	svf_self_portal2;
+qboolean hiResClock;
 
 /*
 ================
@@ -67,29 +70,40 @@ DLLEXPORT intptr_t vmMain( int command, int arg0, int arg1, int arg2 ) {
 		G_ShutdownGame( arg0 );
 		return 0;
 	case GAME_CLIENT_CONNECT:
+		G_RecordClient( REC_CONNECT, arg0, arg1, arg2 );
 		return (intptr_t)ClientConnect( arg0, arg1, arg2 );
 	case GAME_CLIENT_THINK:
 		ClientThink( arg0 );
 		return 0;
 	case GAME_CLIENT_USERINFO_CHANGED:
+		G_RecordClient( REC_USERINFO, arg0, 0, 0 );
 		ClientUserinfoChanged( arg0 );
 		return 0;
 	case GAME_CLIENT_DISCONNECT:
+		G_RecordClient( REC_DISCONNECT, arg0, 0, 0 );
 		ClientDisconnect( arg0 );
 		return 0;
 	case GAME_CLIENT_BEGIN:
+		G_RecordClient( REC_BEGIN, arg0, 0, 0 );
 		ClientBegin( arg0 );
 		return 0;
 	case GAME_CLIENT_COMMAND:
+		G_RecordCommand( arg0 );
 		ClientCommand( arg0 );
 		return 0;
 	case GAME_RUN_FRAME:
+		G_RecordFrame( arg0 );
 		G_RunFrame( arg0 );
 		return 0;
 	case GAME_CONSOLE_COMMAND:
 		return ConsoleCommand();
 	case BOTAI_START_FRAME:
-		return BotAIStartFrame( arg0 );
+		{
+			unsigned int start = G_ProfileBegin();
+			int ret = BotAIStartFrame( arg0 );
+			G_ProfileEnd( PROF_BOTAI, start );
+			return ret;
+		}
 	}
 
 	return -1;
@@ -148,7 +162,7 @@ All but the last will have the teamchain field set to the next one
 */
 void G_FindTeams( void ) {
 	gentity_t	*e, *e2;
-	int		i, j;
+	int		i;
 	int		c, c2;
 
 	c = 0;
@@ -163,27 +177,22 @@ void G_FindTeams( void ) {
 		e->teammaster = e;
 		c++;
 		c2++;
-		for (j=i+1, e2=e+1 ; j < level.num_entities ; j++,e2++)
+		for ( e2 = G_NextTeamMember( e, e->team ) ; e2 ; e2 = G_NextTeamMember( e2, e->team ) )
 		{
-			if (!e2->inuse)
-				continue;
-			if (!e2->team)
-				continue;
 			if (e2->flags & FL_TEAMSLAVE)
 				continue;
-			if (!strcmp(e->team, e2->team))
-			{
-				c2++;
-				e2->teamchain = e->teamchain;
-				e->teamchain = e2;
-				e2->teammaster = e;
-				e2->flags |= FL_TEAMSLAVE;
-
-				// make sure that targets only point at the master
-				if ( e2->targetname ) {
-					e->targetname = e2->targetname;
-					e2->targetname = NULL;
-				}
+			c2++;
+			e2->teamchain = e->teamchain;
+			e->teamchain = e2;
+			e2->teammaster = e;
+			e2->flags |= FL_TEAMSLAVE;
+
+			// make sure that targets only point at the master
+			if ( e2->targetname ) {
+				e->targetname = e2->targetname;
+				e2->targetname = NULL;
+				G_UpdateEntityNames( e );
+				G_UpdateEntityNames( e2 );
 			}
 		}
 	}
@@ -285,16 +294,16 @@ static void G_UpdateCvars( void ) {
 static void G_LocateSpawnSpots( void ) 
 {
 	gentity_t			*ent;
-	int i, n;
+	int n;
 
 	level.spawnSpots[ SPAWN_SPOT_INTERMISSION ] = NULL;
 
 	// locate all spawn spots
 	n = 0;
-	ent = g_entities + MAX_CLIENTS;
-	for ( i = MAX_CLIENTS; i < MAX_GENTITIES; i++, ent++ ) {
+	ent = &g_entities[ MAX_CLIENTS - 1 ];
+	while ( ( ent = G_NextActiveEntity( ent ) ) != NULL ) {
 		
-		if ( !ent->inuse || !ent->classname )
+		if ( !ent->classname )
 			continue;
 
 		// intermission/ffa spots
@@ -380,6 +389,16 @@ static void G_InitGame( int levelTime, int randomSeed, int restart ) {
 		} else {
 			svf_self_portal2 = 0;
 		}
+		if ( trap_GetValue( value, sizeof( value ), "trap_Microseconds" ) ) {
+#ifdef Q3_VM
+			trap_Microseconds = (void*)~atoi( value );
+#else
+			dll_trap_Microseconds = atoi( value );
+#endif
+			hiResClock = qtrue;
+		} else {
+			hiResClock = qfalse;
+		}
 	}
 
 	srand( randomSeed );
@@ -390,6 +409,8 @@ static void G_InitGame( int levelTime, int randomSeed, int restart ) {
 
 	G_InitMemory();
 
+	G_ProfileReset();
+
 	// set some level globals
 	memset( &level, 0, sizeof( level ) );
 	level.time = levelTime;
@@ -399,8 +420,17 @@ static void G_InitGame( int levelTime, int randomSeed, int restart ) {
 	level.previousTime = levelTime;
 	level.msec = FRAMETIME;
 
+	G_InitConfigstringIndexes();
+
 	level.snd_fry = G_SoundIndex("sound/player/fry.wav");	// FIXME standing in lava / slime
 
+	G_UpdateHistorySize();
+
+	G_RecordInit( levelTime, randomSeed );
+	for ( i = 0; i < ARRAY_LEN( gameCvarTable ); i++ ) {
+		G_RecordCvar( gameCvarTable[i].cvarName );
+	}
+
 	if ( g_gametype.integer != GT_SINGLE_PLAYER && g_log.string[0] ) {
 		if ( g_logSync.integer ) {
 			trap_FS_FOpenFile( g_log.string, &level.logFile, FS_APPEND_SYNC );
@@ -426,6 +456,7 @@ static void G_InitGame( int levelTime, int randomSeed, int restart ) {
 	// initialize all entities for this game
 	memset( g_entities, 0, MAX_GENTITIES * sizeof(g_entities[0]) );
 	level.gentities = g_entities;
+	G_InitEntityAlloc();
 
 	// initialize all clients for this game
 	level.maxclients = g_maxclients.integer;
@@ -507,6 +538,8 @@ static void G_ShutdownGame( int restart )
 {
 	G_Printf ("==== ShutdownGame ====\n");
 
+	G_RecordShutdown();
+
 	if ( level.logFile != FS_INVALID_HANDLE ) {
 		G_LogPrintf("ShutdownGame:\n" );
 		G_LogPrintf("------------------------------------------------------------\n" );
@@ -689,58 +722,155 @@ void AdjustTournamentScores( void ) {
 
 /*
 =============
-SortRanks
+G_CompareRanks
+
+Scoreboard order: players by score, then spectators by the time they
+joined the queue, then connecting clients, then scoreboard spectators.
+Ties go to the lower client number so the order is stable.
 =============
 */
-static int QDECL SortRanks( const void *a, const void *b ) {
-	gclient_t	*ca, *cb;
-
-	ca = &level.clients[*(int *)a];
-	cb = &level.clients[*(int *)b];
-
+static int G_RankClass( const gclient_t *cl ) {
 	// sort special clients last
-	if ( ca->sess.spectatorState == SPECTATOR_SCOREBOARD || ca->sess.spectatorClient < 0 ) {
-		return 1;
+	if ( cl->sess.spectatorState == SPECTATOR_SCOREBOARD || cl->sess.spectatorClient < 0 ) {
+		return 3;
 	}
-	if ( cb->sess.spectatorState == SPECTATOR_SCOREBOARD || cb->sess.spectatorClient < 0  ) {
-		return -1;
-	}
-
 	// then connecting clients
-	if ( ca->pers.connected == CON_CONNECTING ) {
+	if ( cl->pers.connected == CON_CONNECTING ) {
+		return 2;
+	}
+	// then spectators
+	if ( cl->sess.sessionTeam == TEAM_SPECTATOR ) {
 		return 1;
 	}
-	if ( cb->pers.connected == CON_CONNECTING ) {
-		return -1;
+	return 0;
+}
+
+static int G_CompareRanks( int a, int b ) {
+	gclient_t	*ca, *cb;
+	int			classA, classB;
+
+	ca = &level.clients[a];
+	cb = &level.clients[b];
+
+	classA = G_RankClass( ca );
+	classB = G_RankClass( cb );
+	if ( classA != classB ) {
+		return classA - classB;
 	}
 
-	// then spectators
-	if ( ca->sess.sessionTeam == TEAM_SPECTATOR && cb->sess.sessionTeam == TEAM_SPECTATOR ) {
-		if ( ca->sess.spectatorTime > cb->sess.spectatorTime ) {
-			return -1;
+	if ( classA == 0 ) {
+		if ( ca->ps.persistant[PERS_SCORE] != cb->ps.persistant[PERS_SCORE] ) {
+			return ca->ps.persistant[PERS_SCORE] > cb->ps.persistant[PERS_SCORE] ? -1 : 1;
 		}
-		if ( ca->sess.spectatorTime < cb->sess.spectatorTime ) {
-			return 1;
+	} else if ( classA == 1 ) {
+		if ( ca->sess.spectatorTime != cb->sess.spectatorTime ) {
+			return ca->sess.spectatorTime > cb->sess.spectatorTime ? -1 : 1;
 		}
-		return 0;
-	}
-	if ( ca->sess.sessionTeam == TEAM_SPECTATOR ) {
-		return 1;
 	}
-	if ( cb->sess.sessionTeam == TEAM_SPECTATOR ) {
-		return -1;
+
+	return a - b;
+}
+
+
+/*
+============
+G_RankClient
+
+Updates the client counters and the membership of level.sortedClients
+after a client connected, entered the game, changed team or left.
+Each client's share of the counters is remembered in level.rankFlags,
+so only this client is looked at.
+============
+*/
+#define RF_CONNECTED		1
+#define RF_NONSPECTATOR		2
+#define RF_PLAYING			4
+#define RF_VOTING			8
+#define RF_VOTING_RED		16
+#define RF_VOTING_BLUE		32
+
+void G_RankClient( int clientNum ) {
+	gclient_t	*cl;
+	int			flags, old, delta, i;
+
+	cl = &level.clients[ clientNum ];
+
+	flags = 0;
+	if ( cl->pers.connected != CON_DISCONNECTED ) {
+		flags |= RF_CONNECTED;
+		if ( cl->sess.sessionTeam != TEAM_SPECTATOR ) {
+			flags |= RF_NONSPECTATOR;
+			if ( cl->pers.connected == CON_CONNECTED ) {
+				flags |= RF_PLAYING;
+				// don't count bots
+				if ( !(g_entities[ clientNum ].r.svFlags & SVF_BOT) ) {
+					flags |= RF_VOTING;
+					if ( cl->sess.sessionTeam == TEAM_RED )
+						flags |= RF_VOTING_RED;
+					else if ( cl->sess.sessionTeam == TEAM_BLUE )
+						flags |= RF_VOTING_BLUE;
+				}
+			}
+		}
 	}
 
-	// then sort by score
-	if ( ca->ps.persistant[PERS_SCORE]
-		> cb->ps.persistant[PERS_SCORE] ) {
-		return -1;
+	old = level.rankFlags[ clientNum ];
+	if ( flags == old ) {
+		return;
 	}
-	if ( ca->ps.persistant[PERS_SCORE]
-		< cb->ps.persistant[PERS_SCORE] ) {
-		return 1;
+	level.rankFlags[ clientNum ] = flags;
+
+	// take the old share out and put the new one in
+	for ( delta = -1; delta <= 1; delta += 2 ) {
+		i = ( delta < 0 ) ? old : flags;
+		if ( i & RF_NONSPECTATOR )
+			level.numNonSpectatorClients += delta;
+		if ( i & RF_PLAYING )
+			level.numPlayingClients += delta;
+		if ( i & RF_VOTING )
+			level.numVotingClients += delta;
+		if ( i & RF_VOTING_RED )
+			level.numteamVotingClients[0] += delta;
+		if ( i & RF_VOTING_BLUE )
+			level.numteamVotingClients[1] += delta;
+	}
+
+	if ( ( flags ^ old ) & RF_CONNECTED ) {
+		if ( flags & RF_CONNECTED ) {
+			// CalculateRanks moves it into place
+			level.sortedClients[ level.numConnectedClients++ ] = clientNum;
+		} else {
+			for ( i = 0; i < level.numConnectedClients; i++ ) {
+				if ( level.sortedClients[i] == clientNum ) {
+					break;
+				}
+			}
+			level.numConnectedClients--;
+			memmove( level.sortedClients + i, level.sortedClients + i + 1,
+				( level.numConnectedClients - i ) * sizeof( level.sortedClients[0] ) );
+		}
 	}
-	return 0;
+}
+
+
+/*
+============
+G_SetScoreConfigstrings
+
+Only touches CS_SCORES1/2 when the values change
+============
+*/
+static void G_SetScoreConfigstrings( int score1, int score2 ) {
+	if ( level.scoresSent && level.scores1 == score1 && level.scores2 == score2 ) {
+		return;
+	}
+
+	trap_SetConfigstring( CS_SCORES1, va( "%i", score1 ) );
+	trap_SetConfigstring( CS_SCORES2, va( "%i", score2 ) );
+
+	level.scores1 = score1;
+	level.scores2 = score2;
+	level.scoresSent = qtrue;
 }
 
 
@@ -751,58 +881,49 @@ CalculateRanks
 Recalculates the score ranks of all players
 This will be called on every client connect, begin, disconnect, death,
 and team change.
+
+The counters are kept by G_RankClient, the order in level.sortedClients
+is kept between calls and only fixed up with an insertion sort, which
+is a single pass when at most a few clients changed places.
 ============
 */
 void CalculateRanks( void ) {
-	int		i;
+	int		i, j;
 	int		rank;
 	int		score;
 	int		newScore;
+	int		clientNum;
 	gclient_t	*cl;
 
 	if ( level.restarted )
 		return;
 
+	G_InvalidateScoreboard();
+
+	for ( i = 1; i < level.numConnectedClients; i++ ) {
+		clientNum = level.sortedClients[i];
+		for ( j = i; j > 0 && G_CompareRanks( clientNum, level.sortedClients[j-1] ) < 0; j-- ) {
+			level.sortedClients[j] = level.sortedClients[j-1];
+		}
+		level.sortedClients[j] = clientNum;
+	}
+
+	// auto-follow the two lowest numbered playing clients
 	level.follow1 = -1;
 	level.follow2 = -1;
-	level.numConnectedClients = 0;
-	level.numNonSpectatorClients = 0;
-	level.numPlayingClients = 0;
-	level.numVotingClients = 0;		// don't count bots
-	for (i = 0; i < ARRAY_LEN(level.numteamVotingClients); i++) {
-		level.numteamVotingClients[i] = 0;
-	}
-	for ( i = 0 ; i < level.maxclients ; i++ ) {
-		if ( level.clients[i].pers.connected != CON_DISCONNECTED ) {
-			level.sortedClients[level.numConnectedClients] = i;
-			level.numConnectedClients++;
-
-			if ( level.clients[i].sess.sessionTeam != TEAM_SPECTATOR ) {
-				level.numNonSpectatorClients++;
-			
-				// decide if this should be auto-followed
-				if ( level.clients[i].pers.connected == CON_CONNECTED ) {
-					level.numPlayingClients++;
-					if ( !(g_entities[i].r.svFlags & SVF_BOT) ) {
-						level.numVotingClients++;
-						if ( level.clients[i].sess.sessionTeam == TEAM_RED )
-							level.numteamVotingClients[0]++;
-						else if ( level.clients[i].sess.sessionTeam == TEAM_BLUE )
-							level.numteamVotingClients[1]++;
-					}
-					if ( level.follow1 == -1 ) {
-						level.follow1 = i;
-					} else if ( level.follow2 == -1 ) {
-						level.follow2 = i;
-					}
-				}
-			}
+	for ( i = 0; i < level.numConnectedClients; i++ ) {
+		clientNum = level.sortedClients[i];
+		if ( !( level.rankFlags[ clientNum ] & RF_PLAYING ) ) {
+			continue;
+		}
+		if ( level.follow1 == -1 || clientNum < level.follow1 ) {
+			level.follow2 = level.follow1;
+			level.follow1 = clientNum;
+		} else if ( level.follow2 == -1 || clientNum < level.follow2 ) {
+			level.follow2 = clientNum;
 		}
 	}
 
-	qsort( level.sortedClients, level.numConnectedClients, 
-		sizeof(level.sortedClients[0]), SortRanks );
-
 	// set the rank value for all clients that are connected and not spectators
 	if ( g_gametype.integer >= GT_TEAM ) {
 		// in team games, rank is just the order of the teams, 0=red, 1=blue, 2=tied
@@ -840,18 +961,15 @@ void CalculateRanks( void ) {
 
 	// set the CS_SCORES1/2 configstrings, which will be visible to everyone
 	if ( g_gametype.integer >= GT_TEAM ) {
-		trap_SetConfigstring( CS_SCORES1, va("%i", level.teamScores[TEAM_RED] ) );
-		trap_SetConfigstring( CS_SCORES2, va("%i", level.teamScores[TEAM_BLUE] ) );
+		G_SetScoreConfigstrings( level.teamScores[TEAM_RED], level.teamScores[TEAM_BLUE] );
 	} else {
 		if ( level.numConnectedClients == 0 ) {
-			trap_SetConfigstring( CS_SCORES1, va("%i", SCORE_NOT_PRESENT) );
-			trap_SetConfigstring( CS_SCORES2, va("%i", SCORE_NOT_PRESENT) );
+			G_SetScoreConfigstrings( SCORE_NOT_PRESENT, SCORE_NOT_PRESENT );
 		} else if ( level.numConnectedClients == 1 ) {
-			trap_SetConfigstring( CS_SCORES1, va("%i", level.clients[ level.sortedClients[0] ].ps.persistant[PERS_SCORE] ) );
-			trap_SetConfigstring( CS_SCORES2, va("%i", SCORE_NOT_PRESENT) );
+			G_SetScoreConfigstrings( level.clients[ level.sortedClients[0] ].ps.persistant[PERS_SCORE], SCORE_NOT_PRESENT );
 		} else {
-			trap_SetConfigstring( CS_SCORES1, va("%i", level.clients[ level.sortedClients[0] ].ps.persistant[PERS_SCORE] ) );
-			trap_SetConfigstring( CS_SCORES2, va("%i", level.clients[ level.sortedClients[1] ].ps.persistant[PERS_SCORE] ) );
+			G_SetScoreConfigstrings( level.clients[ level.sortedClients[0] ].ps.persistant[PERS_SCORE],
+				level.clients[ level.sortedClients[1] ].ps.persistant[PERS_SCORE] );
 		}
 	}
 
@@ -1055,6 +1173,7 @@ void ExitLevel( void ) {
 	// reset all the scores so we don't enter the intermission again
 	level.teamScores[TEAM_RED] = 0;
 	level.teamScores[TEAM_BLUE] = 0;
+	G_InvalidateScoreboard();
 	for ( i = 0 ; i < level.maxclients ; i++ ) {
 		cl = level.clients + i;
 		if ( cl->pers.connected != CON_CONNECTED ) {
@@ -1071,6 +1190,7 @@ void ExitLevel( void ) {
 	for ( i = 0 ; i < level.maxclients ; i++ ) {
 		if ( level.clients[i].pers.connected == CON_CONNECTED ) {
 			level.clients[i].pers.connected = CON_CONNECTING;
+			G_RankClient( i );
 		}
 	}
 
@@ -1096,8 +1216,8 @@ Print to the logfile with a time stamp if it is open
 */
 void QDECL G_LogPrintf( const char *fmt, ... ) {
 	va_list		argptr;
-	char		string[BIG_INFO_STRING];
-	int			min, tsec, sec, len, n;
+	char		*string;
+	int			min, tsec, sec, len, n, mark;
 
 	tsec = level.time / 100;
 	sec = tsec / 10;
@@ -1105,7 +1225,10 @@ void QDECL G_LogPrintf( const char *fmt, ... ) {
 	min = sec / 60;
 	sec -= min * 60;
 
-	len = Com_sprintf( string, sizeof( string ), "%3i:%02i.%i ", min, sec, tsec );
+	mark = G_ArenaMark( MEM_FRAME );
+	string = G_ArenaAlloc( MEM_FRAME, BIG_INFO_STRING );
+
+	len = Com_sprintf( string, BIG_INFO_STRING, "%3i:%02i.%i ", min, sec, tsec );
 
 	va_start( argptr, fmt );
 	Q_vsprintf( string + len, fmt,argptr );
@@ -1117,11 +1240,11 @@ void QDECL G_LogPrintf( const char *fmt, ... ) {
 		G_Printf( "%s", string + len );
 	}
 
-	if ( level.logFile == FS_INVALID_HANDLE ) {
-		return;
+	if ( level.logFile != FS_INVALID_HANDLE ) {
+		trap_FS_Write( string, n, level.logFile );
 	}
 
-	trap_FS_Write( string, n, level.logFile );
+	G_ArenaRelease( MEM_FRAME, mark );
 }
 
 
@@ -1439,12 +1562,12 @@ static void G_WarmupEnd( void )
 	Team_ResetFlags();
 
 	memset( level.teamScores, 0, sizeof( level.teamScores ) );
+	G_InvalidateScoreboard();
 
 	level.warmupTime = 0;
 	level.startTime = level.time;
 
-	trap_SetConfigstring( CS_SCORES1, "0" );
-	trap_SetConfigstring( CS_SCORES2, "0" );
+	G_SetScoreConfigstrings( 0, 0 );
 	trap_SetConfigstring( CS_WARMUP, "" );
 	trap_SetConfigstring( CS_LEVEL_START_TIME, va( "%i", level.startTime ) );
 	
@@ -1490,7 +1613,7 @@ static void G_WarmupEnd( void )
 			continue;
 
 		if ( ent->tag == TAG_DONTSPAWN ) {
-			ent->nextthink = 0;
+			G_SetNextThink( ent, 0 );
 			continue;
 		}
 
@@ -1502,7 +1625,7 @@ static void G_WarmupEnd( void )
 
 			// remove dropped items
 			if ( ent->flags & FL_DROPPED_ITEM ) {
-				ent->nextthink = level.time;
+				G_SetNextThink( ent, level.time );
 				continue;
 			}
 
@@ -1528,7 +1651,7 @@ static void G_WarmupEnd( void )
 					t = FRAMETIME;
 				}
 			}
-			ent->nextthink = level.time + t;
+			G_SetNextThink( ent, level.time + t );
 
 		} else if ( ent->s.eType == ET_MISSILE ) {
 			// remove all launched missiles
@@ -1861,6 +1984,9 @@ CheckCvars
 void CheckCvars( void ) {
 	static int lastMod = -1;
 
+	// unlagged
+	G_UpdateHistorySize();
+
 	if ( lastMod != g_password.modificationCount ) {
 		lastMod = g_password.modificationCount;
 		if ( g_password.string[0] && Q_stricmp( g_password.string, "none" ) != 0 ) {
@@ -1890,15 +2016,59 @@ void G_RunThink( gentity_t *ent ) {
 		return;
 	}
 	
-	ent->nextthink = 0;
+	G_SetNextThink( ent, 0 );
 	if ( !ent->think ) {
 		G_Error ( "NULL ent->think");
 	} else {
+		level.frameThinks++;
 		ent->think (ent);
 	}
 }
 
 
+/*
+=============
+G_RunScheduledThinks
+
+Runs the thinks that are due for entities that G_RunFrame doesn't
+process on their own, i.e. anything that is not a client, missile,
+item, physics object or mover
+=============
+*/
+static void G_RunScheduledThinks( void ) {
+	static int	due[ MAX_GENTITIES ];
+	gentity_t	*ent;
+	int			i, n;
+
+	// collect first, thinks that schedule themselves for
+	// this frame again must wait for the next one
+	n = G_PopDueThinks( due );
+
+	for ( i = 0; i < n; i++ ) {
+		ent = &g_entities[ due[ i ] ];
+
+		// freed or rescheduled by an earlier think
+		if ( !ent->inuse || ent->nextthink <= 0 || ent->nextthink > level.time ) {
+			continue;
+		}
+
+		// handled by their own runners
+		if ( due[ i ] < MAX_CLIENTS || ent->s.eType == ET_MISSILE || ent->s.eType == ET_ITEM
+			|| ent->physicsObject || ent->s.eType == ET_MOVER ) {
+			continue;
+		}
+
+		// temporary entities don't think, try again next frame
+		if ( ent->freeAfterEvent || ( !ent->r.linked && ent->neverFree ) ) {
+			G_SetNextThink( ent, ent->nextthink );
+			continue;
+		}
+
+		G_RunThink( ent );
+	}
+}
+
+
 /*
 ================
 G_RunFrame
@@ -1912,13 +2082,20 @@ static void G_RunFrame( int levelTime ) {
 	gclient_t	*client;
 	static	gentity_t *missiles[ MAX_GENTITIES - MAX_CLIENTS ];
 	int		numMissiles;
+	unsigned int	frameStart, start;
 	
+	G_ResetFrameMemory();
+
 	// if we are waiting for the level to restart, do nothing
 	if ( level.restarted ) {
 		return;
 	}
 
 	level.framenum++;
+	if ( level.frameThinks > level.peakThinks ) {
+		level.peakThinks = level.frameThinks;
+	}
+	level.frameThinks = 0;
 	level.previousTime = level.time;
 	level.time = levelTime;
 	level.msec = level.time - level.previousTime;
@@ -1926,16 +2103,16 @@ static void G_RunFrame( int levelTime ) {
 	// get any cvar changes
 	G_UpdateCvars();
 
+	frameStart = G_ProfileBegin();
+
 	numMissiles = 0;
 
 	//
 	// go through all allocated objects
 	//
-	ent = &g_entities[0];
-	for (i=0 ; i<level.num_entities ; i++, ent++) {
-		if ( !ent->inuse ) {
-			continue;
-		}
+	start = G_ProfileBegin();
+	for ( ent = G_NextActiveEntity( NULL ); ent; ent = G_NextActiveEntity( ent ) ) {
+		i = ent - g_entities;
 
 		// clear events that are too old
 		if ( level.time - ent->eventTime > EVENT_VALID_MSEC ) {
@@ -1993,35 +2170,46 @@ static void G_RunFrame( int levelTime ) {
 			continue;
 		}
 
-		G_RunThink( ent );
+		// everything else thinks from the schedule
 	}
 
+	G_RunScheduledThinks();
+	G_ProfileEnd( PROF_ENTITIES, start );
+
 	if ( numMissiles ) {
+		start = G_ProfileBegin();
 		// unlagged
-		G_TimeShiftAllClients( level.previousTime, NULL );
+		G_TimeShiftClientsForMissiles( level.previousTime, missiles, numMissiles );
 		// run missiles
 		for ( i = 0; i < numMissiles; i++ )
 			G_RunMissile( missiles[ i ] );
 		// unlagged
 		G_UnTimeShiftAllClients( NULL );
+		G_ProfileEnd( PROF_MISSILES, start );
 	}
 
 	// perform final fixups on the players
+	start = G_ProfileBegin();
 	ent = &g_entities[0];
 	for (i = 0 ; i < level.maxclients ; i++, ent++ ) {
 		if ( ent->inuse ) {
 			ClientEndFrame( ent );
 		}
 	}
+	G_ProfileEnd( PROF_CLIENT_END_FRAME, start );
 
 	// see if it is time to do a tournement restart
 	CheckTournament();
 
 	// see if it is time to end the level
+	start = G_ProfileBegin();
 	CheckExitRules();
+	G_ProfileEnd( PROF_EXIT_RULES, start );
 
 	// update to team status?
+	start = G_ProfileBegin();
 	CheckTeamStatus();
+	G_ProfileEnd( PROF_TEAM_STATUS, start );
 
 	// cancel vote if timed out
 	CheckVote();
@@ -2040,6 +2228,8 @@ static void G_RunFrame( int levelTime ) {
 		trap_Cvar_Set("g_listEntity", "0");
 	}
 
+	G_ProfileEnd( PROF_FRAME, frameStart );
+
 	// unlagged
 	level.frameStartTime = trap_Milliseconds();
 }
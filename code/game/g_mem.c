@@ -7,35 +7,366 @@
 
 #include "g_local.h"
 
+/*
+=========================================================================
 
-#define POOLSIZE	(768 * 1024)
+memory arenas
+
+A single static pool is split into three bump allocators:
+
+  persistent	laid out once when the module is loaded and never reset,
+				for things that outlive a map like the bot states
+  frame			reset at the start of every G_RunFrame, for scratch
+				buffers, users can also give their space back with
+				G_ArenaMark / G_ArenaRelease
+  level			reset by G_InitMemory on every map load, for spawn
+				strings and everything else G_Alloc hands out
+
+The sizes come from the latched g_persistentMemory, g_frameMemory and
+g_levelMemory cvars in kilobytes.  Each arena remembers the most it ever
+had in use, "game_memory" prints them to help size the cvars.
+
+=========================================================================
+*/
+
+// the default arenas plus 512 KB to raise the cvars into
+#define POOLSIZE	( ( 1536 + 640 + 64 + 512 ) * 1024 )
+#define MEM_ALIGN	32
+
+// G_LogPrintf builds its lines in the frame arena
+#define FRAME_MEMORY_MIN	( ( BIG_INFO_STRING + MEM_ALIGN - 1 ) & ~( MEM_ALIGN - 1 ) )
+
+typedef struct {
+	const char	*name;
+	const char	*cvarName;
+	vmCvar_t	*size_kb;
+	int			minSize;		// whatever the cvar says
+	int			base;			// offset into memoryPool
+	int			size;
+	int			used;
+	int			highWater;
+	int			numAllocs;		// since the last reset
+} memArenaInfo_t;
 
 static char		memoryPool[POOLSIZE];
-static int		allocPoint;
 
-void *G_Alloc( size_t size ) {
-	char	*p;
+static memArenaInfo_t memArenas[ MEM_NUM_ARENAS ] = {
+	{ "level", "g_levelMemory", &g_levelMemory, 0 },
+	{ "persistent", "g_persistentMemory", &g_persistentMemory, 0 },
+	{ "frame", "g_frameMemory", &g_frameMemory, FRAME_MEMORY_MIN }
+};
+
+static qboolean	persistentLaidOut;
+
+
+/*
+=========================================================================
+
+interned strings
+
+Every string G_NewString hands out lives once in the level arena and is
+found again through a hash table, so a map full of identical classnames
+or models shares one copy of each.  Two interned strings are equal
+exactly when their pointers are, which the atom fields of gentity_t rely
+on.
+
+Target names have always been matched ignoring case, so G_NewName keeps
+them in a table of their own that hashes and compares them that way.
+Every spelling of a name gets the pointer of the one interned first.
+
+Both tables are emptied together with the level arena.
+
+=========================================================================
+*/
+
+#define STRING_HASH_SIZE	1024
+
+typedef struct internString_s {
+	struct internString_s	*next;
+	char					string[4];		// variable sized
+} internString_t;
+
+static internString_t	*stringHash[ STRING_HASH_SIZE ];
+static internString_t	*nameHash[ STRING_HASH_SIZE ];
+static int				numStrings;
+static int				stringBytes;
+static int				stringLookups;
+static int				stringShared;
+
+
+/*
+================
+G_ArenaSize
+
+Returns the cvar size raised to the arena minimum and clamped to what
+is left of the pool
+================
+*/
+static int G_ArenaSize( memArenaInfo_t *arena, int avail ) {
+	int size;
+
+	size = ( arena->size_kb->integer * 1024 ) & ~( MEM_ALIGN - 1 );
+	if ( size < arena->minSize ) {
+		size = arena->minSize;
+	}
+	if ( size > avail ) {
+		G_Printf( S_COLOR_YELLOW "WARNING: %s limited to %i\n", arena->cvarName, avail / 1024 );
+		size = avail;
+	}
 
-	if ( g_debugAlloc.integer ) {
-		G_Printf( "G_Alloc of %i bytes (%i left)\n", size, POOLSIZE - allocPoint - ( ( size + 31 ) & ~31 ) );
+	return size;
+}
+
+
+/*
+================
+G_InitMemory
+
+Lays out the arenas and resets the level and frame arenas
+================
+*/
+void G_InitMemory( void ) {
+	memArenaInfo_t *persistent, *frame, *level;
+
+	persistent = &memArenas[ MEM_PERSISTENT ];
+	frame = &memArenas[ MEM_FRAME ];
+	level = &memArenas[ MEM_LEVEL ];
+
+	if ( !persistentLaidOut ) {
+		persistent->base = 0;
+		persistent->size = G_ArenaSize( persistent, POOLSIZE / 2 );
+		persistentLaidOut = qtrue;
 	}
 
-	if ( allocPoint + size > POOLSIZE ) {
-		G_Error( "G_Alloc: failed on allocation of %i bytes", size );
+	frame->base = persistent->base + persistent->size;
+	frame->size = G_ArenaSize( frame, POOLSIZE - frame->base );
+	frame->used = 0;
+	frame->numAllocs = 0;
+
+	level->base = frame->base + frame->size;
+	level->size = G_ArenaSize( level, POOLSIZE - level->base );
+	level->used = 0;
+	level->numAllocs = 0;
+
+	memset( stringHash, 0, sizeof( stringHash ) );
+	memset( nameHash, 0, sizeof( nameHash ) );
+	numStrings = stringBytes = stringLookups = stringShared = 0;
+}
+
+
+/*
+================
+G_ArenaAlloc
+================
+*/
+void *G_ArenaAlloc( memArena_t id, int size ) {
+	memArenaInfo_t	*arena;
+	char			*p;
+
+	arena = &memArenas[ id ];
+	size = ( size + MEM_ALIGN - 1 ) & ~( MEM_ALIGN - 1 );
+
+	// scratch allocations would flood the console
+	if ( g_debugAlloc.integer && id != MEM_FRAME ) {
+		G_Printf( "G_Alloc of %i bytes from %s (%i left)\n", size, arena->name, arena->size - arena->used - size );
+	}
+
+	if ( arena->used + size > arena->size ) {
+		G_Error( "G_Alloc: failed on allocation of %i bytes from the %s arena, raise %s",
+			size, arena->name, arena->cvarName );
 		return NULL;
 	}
 
-	p = &memoryPool[allocPoint];
+	p = &memoryPool[ arena->base + arena->used ];
 
-	allocPoint += ( size + 31 ) & ~31;
+	arena->used += size;
+	arena->numAllocs++;
+	if ( arena->used > arena->highWater ) {
+		arena->highWater = arena->used;
+	}
 
 	return p;
 }
 
-void G_InitMemory( void ) {
-	allocPoint = 0;
+
+void *G_Alloc( size_t size ) {
+	return G_ArenaAlloc( MEM_LEVEL, (int)size );
+}
+
+
+/*
+================
+G_ArenaMark
+
+Returns a mark to hand back to G_ArenaRelease, which frees
+everything allocated from the arena after it
+================
+*/
+int G_ArenaMark( memArena_t id ) {
+	return memArenas[ id ].used;
 }
 
+
+void G_ArenaRelease( memArena_t id, int mark ) {
+	if ( mark >= 0 && mark <= memArenas[ id ].used ) {
+		memArenas[ id ].used = mark;
+	}
+}
+
+
+void G_ResetFrameMemory( void ) {
+	memArenas[ MEM_FRAME ].used = 0;
+	memArenas[ MEM_FRAME ].numAllocs = 0;
+}
+
+
+/*
+================
+G_StringHash
+================
+*/
+static int G_StringHash( const char *string, qboolean ignoreCase ) {
+	unsigned int	hash;
+	int				c;
+
+	hash = 0;
+	while ( *string ) {
+		c = (unsigned char)*string;
+		if ( ignoreCase && c >= 'A' && c <= 'Z' ) {
+			c += 'a' - 'A';
+		}
+		hash = hash * 31 + c;
+		string++;
+	}
+
+	return hash & ( STRING_HASH_SIZE - 1 );
+}
+
+
+/*
+================
+G_LookupString
+================
+*/
+static const char *G_LookupString( internString_t **table, int hash, const char *string, qboolean ignoreCase ) {
+	internString_t	*s;
+
+	for ( s = table[ hash ]; s; s = s->next ) {
+		if ( ignoreCase ? !Q_stricmp( s->string, string ) : !strcmp( s->string, string ) ) {
+			return s->string;
+		}
+	}
+
+	return NULL;
+}
+
+
+/*
+================
+G_AddString
+================
+*/
+static const char *G_AddString( internString_t **table, int hash, const char *string ) {
+	internString_t	*s;
+	int				len;
+
+	len = (int)strlen( string ) + 1;
+	s = G_Alloc( sizeof( *s ) - sizeof( s->string ) + len );
+	memcpy( s->string, string, len );
+	s->next = table[ hash ];
+	table[ hash ] = s;
+
+	numStrings++;
+	stringBytes += len;
+
+	return s->string;
+}
+
+
+/*
+================
+G_FindString
+
+Returns the interned copy of string, or NULL if nothing has interned it
+this level, in which case no atom field can hold it either
+================
+*/
+const char *G_FindString( const char *string ) {
+	stringLookups++;
+	return G_LookupString( stringHash, G_StringHash( string, qfalse ), string, qfalse );
+}
+
+
+/*
+================
+G_InternString
+
+Returns the shared level lifetime copy of string, which must not be
+written to
+================
+*/
+const char *G_InternString( const char *string ) {
+	const char	*s;
+	int			hash;
+
+	hash = G_StringHash( string, qfalse );
+	s = G_LookupString( stringHash, hash, string, qfalse );
+	if ( s ) {
+		stringShared++;
+		return s;
+	}
+
+	return G_AddString( stringHash, hash, string );
+}
+
+
+/*
+================
+G_FindName
+
+G_FindString for the names interned by G_InternName
+================
+*/
+const char *G_FindName( const char *name ) {
+	stringLookups++;
+	return G_LookupString( nameHash, G_StringHash( name, qtrue ), name, qtrue );
+}
+
+
+/*
+================
+G_InternName
+
+Returns the shared copy of name, the same for every spelling of it
+that only differs in case
+================
+*/
+const char *G_InternName( const char *name ) {
+	const char	*s;
+	int			hash;
+
+	hash = G_StringHash( name, qtrue );
+	s = G_LookupString( nameHash, hash, name, qtrue );
+	if ( s ) {
+		stringShared++;
+		return s;
+	}
+
+	return G_AddString( nameHash, hash, name );
+}
+
+
 void Svcmd_GameMem_f( void ) {
-	G_Printf( "Game memory status: %i out of %i bytes allocated\n", allocPoint, POOLSIZE );
+	memArenaInfo_t	*arena;
+	int				i, used;
+
+	G_Printf( "Game memory status:\n" );
+	G_Printf( "%-10s %9s %9s %9s %7s\n", "arena", "used", "peak", "size", "allocs" );
+	for ( i = 0, used = 0; i < MEM_NUM_ARENAS; i++ ) {
+		arena = &memArenas[ i ];
+		G_Printf( "%-10s %9i %9i %9i %7i\n", arena->name, arena->used, arena->highWater, arena->size, arena->numAllocs );
+		used += arena->size;
+	}
+	G_Printf( "%i out of %i bytes of the pool laid out\n", used, POOLSIZE );
+	G_Printf( "%i strings in %i bytes, %i shared, %i lookups\n", numStrings, stringBytes, stringShared, stringLookups );
 }
@@ -110,7 +110,7 @@ void TeleportPlayer( gentity_t *player, vec3_t origin, vec3_t angles ) {
 	VectorCopy( player->client->ps.origin, player->r.currentOrigin );
 
 	if ( player->client->sess.sessionTeam != TEAM_SPECTATOR ) {
-		trap_LinkEntity( player );
+		G_LinkEntity( player );
 	}
 }
 
@@ -135,7 +135,7 @@ void SP_misc_model( gentity_t *ent ) {
 	ent->s.modelindex = G_ModelIndex( ent->model );
 	VectorSet (ent->mins, -16, -16, -16);
 	VectorSet (ent->maxs, 16, 16, 16);
-	trap_LinkEntity (ent);
+	G_LinkEntity (ent);
 
 	G_SetOrigin( ent, ent->s.origin );
 	VectorCopy( ent->s.angles, ent->s.apos.trBase );
@@ -199,7 +199,7 @@ This must be within 64 world units of the surface!
 void SP_misc_portal_surface(gentity_t *ent) {
 	VectorClear( ent->r.mins );
 	VectorClear( ent->r.maxs );
-	trap_LinkEntity (ent);
+	G_LinkEntity (ent);
 
 	ent->r.svFlags = SVF_PORTAL;
 	ent->s.eType = ET_PORTAL;
@@ -208,7 +208,7 @@ void SP_misc_portal_surface(gentity_t *ent) {
 		VectorCopy( ent->s.origin, ent->s.origin2 );
 	} else {
 		ent->think = locateCamera;
-		ent->nextthink = level.time + 100;
+		G_SetNextThink( ent, level.time + 100 );
 	}
 }
 
@@ -221,7 +221,7 @@ void SP_misc_portal_camera(gentity_t *ent) {
 
 	VectorClear( ent->r.mins );
 	VectorClear( ent->r.maxs );
-	trap_LinkEntity (ent);
+	G_LinkEntity (ent);
 
 	G_SpawnFloat( "roll", "0", &roll );
 
@@ -280,7 +280,7 @@ void Use_Shooter( gentity_t *ent, gentity_t *other, gentity_t *activator ) {
 static void InitShooter_Finish( gentity_t *ent ) {
 	ent->enemy = G_PickTarget( ent->target );
 	ent->think = 0;
-	ent->nextthink = 0;
+	G_SetNextThink( ent, 0 );
 }
 
 void InitShooter( gentity_t *ent, int weapon ) {
@@ -298,9 +298,9 @@ void InitShooter( gentity_t *ent, int weapon ) {
 	// target might be a moving object, so we can't set movedir for it
 	if ( ent->target ) {
 		ent->think = InitShooter_Finish;
-		ent->nextthink = level.time + 500;
+		G_SetNextThink( ent, level.time + 500 );
 	}
-	trap_LinkEntity( ent );
+	G_LinkEntity( ent );
 }
 
 /*QUAKED shooter_rocket (1 0 0) (-16 -16 -16) (16 16 16)
@@ -354,15 +354,16 @@ void DropPortalDestination( gentity_t *player ) {
 
 	ent->r.contents = CONTENTS_CORPSE;
 	ent->takedamage = qtrue;
+	G_AddDamageable( ent );
 	ent->health = 200;
 	ent->die = PortalDie;
 
 	VectorCopy( player->s.apos.trBase, ent->s.angles );
 
 	ent->think = G_FreeEntity;
-	ent->nextthink = level.time + 2 * 60 * 1000;
+	G_SetNextThink( ent, level.time + 2 * 60 * 1000 );
 
-	trap_LinkEntity( ent );
+	G_LinkEntity( ent );
 
 	player->client->portalID = ++level.portalSequence;
 	ent->count = player->client->portalID;
@@ -423,7 +424,7 @@ static void PortalTouch( gentity_t *self, gentity_t *other, trace_t *trace) {
 static void PortalEnable( gentity_t *self ) {
 	self->touch = PortalTouch;
 	self->think = G_FreeEntity;
-	self->nextthink = level.time + 2 * 60 * 1000;
+	G_SetNextThink( self, level.time + 2 * 60 * 1000 );
 }
 
 
@@ -447,17 +448,18 @@ void DropPortalSource( gentity_t *player ) {
 
 	ent->r.contents = CONTENTS_CORPSE | CONTENTS_TRIGGER;
 	ent->takedamage = qtrue;
+	G_AddDamageable( ent );
 	ent->health = 200;
 	ent->die = PortalDie;
 
-	trap_LinkEntity( ent );
+	G_LinkEntity( ent );
 
 	ent->count = player->client->portalID;
 	player->client->portalID = 0;
 
 //	ent->spawnflags = player->client->ps.persistant[PERS_TEAM];
 
-	ent->nextthink = level.time + 1000;
+	G_SetNextThink( ent, level.time + 1000 );
 	ent->think = PortalEnable;
 
 	// find the destination
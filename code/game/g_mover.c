@@ -155,7 +155,7 @@ qboolean	G_TryPushingEntity( gentity_t *check, gentity_t *pusher, vec3_t move, v
 		} else {
 			VectorCopy( check->s.pos.trBase, check->r.currentOrigin );
 		}
-		trap_LinkEntity (check);
+		G_LinkEntity (check);
 		return qtrue;
 	}
 
@@ -225,7 +225,7 @@ qboolean G_TryPushingProxMine( gentity_t *check, gentity_t *pusher, vec3_t move,
 	ret = G_CheckProxMinePosition( check );
 	if (ret) {
 		VectorCopy( check->s.pos.trBase, check->r.currentOrigin );
-		trap_LinkEntity (check);
+		G_LinkEntity (check);
 	}
 	return ret;
 }
@@ -291,7 +291,7 @@ qboolean G_MoverPush( gentity_t *pusher, vec3_t move, vec3_t amove, gentity_t **
 	// move the pusher to its final position
 	VectorAdd( pusher->r.currentOrigin, move, pusher->r.currentOrigin );
 	VectorAdd( pusher->r.currentAngles, amove, pusher->r.currentAngles );
-	trap_LinkEntity( pusher );
+	G_LinkEntity( pusher );
 
 	// see if any solid entities are inside the final position
 	for ( e = 0 ; e < listedEntities ; e++ ) {
@@ -383,7 +383,7 @@ qboolean G_MoverPush( gentity_t *pusher, vec3_t move, vec3_t amove, gentity_t **
 				p->ent->client->ps.delta_angles[YAW] = p->deltayaw;
 				VectorCopy (p->origin, p->ent->client->ps.origin);
 			}
-			trap_LinkEntity (p->ent);
+			G_LinkEntity (p->ent);
 		}
 		return qfalse;
 	}
@@ -426,7 +426,7 @@ void G_MoverTeam( gentity_t *ent ) {
 			part->s.apos.trTime += level.time - level.previousTime;
 			BG_EvaluateTrajectory( &part->s.pos, level.time, part->r.currentOrigin );
 			BG_EvaluateTrajectory( &part->s.apos, level.time, part->r.currentAngles );
-			trap_LinkEntity( part );
+			G_LinkEntity( part );
 		}
 
 		// if the pusher has a "blocked" function, call it
@@ -518,7 +518,7 @@ void SetMoverState( gentity_t *ent, moverState_t moverState, int time ) {
 		break;
 	}
 	BG_EvaluateTrajectory( &ent->s.pos, level.time, ent->r.currentOrigin );	
-	trap_LinkEntity( ent );
+	G_LinkEntity( ent );
 }
 
 /*
@@ -578,7 +578,7 @@ void Reached_BinaryMover( gentity_t *ent ) {
 
 		// return to pos1 after a delay
 		ent->think = ReturnToPos1;
-		ent->nextthink = level.time + ent->wait;
+		G_SetNextThink( ent, level.time + ent->wait );
 
 		// fire targets
 		if ( !ent->activator ) {
@@ -643,7 +643,7 @@ void Use_BinaryMover( gentity_t *ent, gentity_t *other, gentity_t *activator ) {
 
 	// if all the way up, just delay before coming down
 	if ( ent->moverState == MOVER_POS2 ) {
-		ent->nextthink = level.time + ent->wait;
+		G_SetNextThink( ent, level.time + ent->wait );
 		return;
 	}
 
@@ -742,7 +742,7 @@ void InitMover( gentity_t *ent ) {
 	ent->r.svFlags = SVF_USE_CURRENT_ORIGIN;
 	ent->s.eType = ET_MOVER;
 	VectorCopy (ent->pos1, ent->r.currentOrigin);
-	trap_LinkEntity (ent);
+	G_LinkEntity (ent);
 
 	ent->s.pos.trType = TR_STATIONARY;
 	VectorCopy( ent->pos1, ent->s.pos.trBase );
@@ -871,6 +871,7 @@ void Think_SpawnNewDoorTrigger( gentity_t *ent ) {
 	// set all of the slaves as shootable
 	for ( other = ent ; other ; other = other->teamchain ) {
 		other->takedamage = qtrue;
+		G_AddDamageable( other );
 	}
 
 	// find the bounds of everything on the team
@@ -902,7 +903,7 @@ void Think_SpawnNewDoorTrigger( gentity_t *ent ) {
 	other->touch = Touch_DoorTrigger;
 	// remember the thinnest axis
 	other->count = best;
-	trap_LinkEntity (other);
+	G_LinkEntity (other);
 
 	MatchTeam( ent, ent->moverState, level.time );
 }
@@ -983,7 +984,7 @@ void SP_func_door (gentity_t *ent) {
 
 	InitMover( ent );
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( ent, level.time + FRAMETIME );
 
 	if ( ! (ent->flags & FL_TEAMSLAVE ) ) {
 		int health;
@@ -991,6 +992,7 @@ void SP_func_door (gentity_t *ent) {
 		G_SpawnInt( "health", "0", &health );
 		if ( health ) {
 			ent->takedamage = qtrue;
+			G_AddDamageable( ent );
 		}
 		if ( ent->targetname || health ) {
 			// non touch/shoot doors
@@ -1025,7 +1027,7 @@ void Touch_Plat( gentity_t *ent, gentity_t *other, trace_t *trace ) {
 
 	// delay return-to-pos1 by one second
 	if ( ent->moverState == MOVER_POS2 ) {
-		ent->nextthink = level.time + 1000;
+		G_SetNextThink( ent, level.time + 1000 );
 	}
 }
 
@@ -1088,7 +1090,7 @@ void SpawnPlatTrigger( gentity_t *ent ) {
 	VectorCopy (tmin, trigger->r.mins);
 	VectorCopy (tmax, trigger->r.maxs);
 
-	trap_LinkEntity (trigger);
+	G_LinkEntity (trigger);
 }
 
 
@@ -1221,6 +1223,7 @@ void SP_func_button( gentity_t *ent ) {
 	if (ent->health) {
 		// shootable button
 		ent->takedamage = qtrue;
+		G_AddDamageable( ent );
 	} else {
 		// touchable button
 		ent->touch = Touch_Button;
@@ -1306,7 +1309,7 @@ void Reached_Train( gentity_t *ent ) {
 
 	// if there is a "wait" value on the target, don't start moving yet
 	if ( next->wait ) {
-		ent->nextthink = level.time + next->wait * 1000;
+		G_SetNextThink( ent, level.time + next->wait * 1000 );
 		ent->think = Think_BeginMoving;
 		ent->s.pos.trType = TR_STATIONARY;
 	}
@@ -1323,7 +1326,7 @@ Link all the corners together
 void Think_SetupTrainTargets( gentity_t *ent ) {
 	gentity_t		*path, *next, *start;
 
-	ent->nextTrain = G_Find( NULL, FOFS(targetname), ent->target );
+	ent->nextTrain = G_NextTarget( NULL, ent->target );
 	if ( !ent->nextTrain ) {
 		G_Printf( "func_train at %s with an unfound target\n",
 			vtos(ent->r.absmin) );
@@ -1347,7 +1350,7 @@ void Think_SetupTrainTargets( gentity_t *ent ) {
 		// is reached
 		next = NULL;
 		do {
-			next = G_Find( next, FOFS(targetname), path->target );
+			next = G_NextTarget( next, path->target );
 			if ( !next ) {
 				G_Printf( "Train corner at %s without a target path_corner\n",
 					vtos(path->s.origin) );
@@ -1421,7 +1424,7 @@ void SP_func_train (gentity_t *self) {
 
 	// start trains on the second frame, to make sure their targets have had
 	// a chance to spawn
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 	self->think = Think_SetupTrainTargets;
 }
 
@@ -1494,7 +1497,7 @@ void SP_func_rotating (gentity_t *ent) {
 	VectorCopy( ent->s.pos.trBase, ent->r.currentOrigin );
 	VectorCopy( ent->s.apos.trBase, ent->r.currentAngles );
 
-	trap_LinkEntity( ent );
+	G_LinkEntity( ent );
 }
 
 
@@ -0,0 +1,184 @@
+// Public Domain
+
+#include "g_local.h"
+
+/*
+=========================================================================
+
+frame profiler
+
+Enabled with g_profile 1.  Each scope keeps a rolling window of its
+last PROFILE_SAMPLES timings in microseconds, "profile" prints their
+min/avg/p99/max.  Counters just add up until the next reset.  The clock comes from the trap_Microseconds engine
+extension when available, otherwise it falls back to trap_Milliseconds.
+
+=========================================================================
+*/
+
+#define PROFILE_SAMPLES		1024
+
+typedef struct {
+	int		samples[ PROFILE_SAMPLES ];
+	int		head;
+	int		count;				// valid samples, up to PROFILE_SAMPLES
+	int		calls;				// since the last reset
+} profileScope_t;
+
+static profileScope_t profileScopes[ PROF_NUM_SCOPES ];
+static int profileCounters[ PCOUNT_NUM_COUNTERS ];
+
+static const char *profileNames[ PROF_NUM_SCOPES ] = {
+	"G_RunFrame",
+	"entities",
+	"missiles",
+	"ClientEndFrame",
+	"CheckExitRules",
+	"CheckTeamStatus",
+	"BotAIStartFrame",
+	"ClientThink_real",
+	"G_RadiusDamage"
+};
+
+static const char *profileCounterNames[ PCOUNT_NUM_COUNTERS ] = {
+	"radius damage targets",
+	"out of range, CanDamage skipped",
+	"CanDamage calls"
+};
+
+
+/*
+================
+G_ProfileClock
+
+Microseconds, also used outside the profiler to measure work against a budget
+================
+*/
+unsigned int G_ProfileClock( void ) {
+	if ( hiResClock ) {
+		return (unsigned int)trap_Microseconds();
+	}
+	// wraps with the microsecond clock, take differences unsigned
+	return (unsigned int)trap_Milliseconds() * 1000u;
+}
+
+
+/*
+================
+G_ProfileReset
+================
+*/
+void G_ProfileReset( void ) {
+	memset( profileScopes, 0, sizeof( profileScopes ) );
+	memset( profileCounters, 0, sizeof( profileCounters ) );
+}
+
+
+/*
+================
+G_ProfileBegin
+
+Returns the start time to pass to G_ProfileEnd
+================
+*/
+unsigned int G_ProfileBegin( void ) {
+	if ( !g_profile.integer ) {
+		return 0;
+	}
+	return G_ProfileClock();
+}
+
+
+/*
+================
+G_ProfileEnd
+================
+*/
+void G_ProfileEnd( profileScopeId_t id, unsigned int start ) {
+	profileScope_t *scope;
+	int usec;
+
+	if ( !g_profile.integer ) {
+		return;
+	}
+
+	// unsigned, the microsecond clock wraps every 71 minutes
+	usec = G_ProfileClock() - start;
+
+	scope = &profileScopes[ id ];
+	scope->samples[ scope->head ] = usec;
+	scope->head = ( scope->head + 1 ) % PROFILE_SAMPLES;
+	if ( scope->count < PROFILE_SAMPLES ) {
+		scope->count++;
+	}
+	scope->calls++;
+}
+
+
+void G_ProfileCount( profileCounterId_t id, int count ) {
+	if ( g_profile.integer ) {
+		profileCounters[ id ] += count;
+	}
+}
+
+
+static int QDECL G_ProfileCompare( const void *a, const void *b ) {
+	return *(const int *)a - *(const int *)b;
+}
+
+
+/*
+================
+Svcmd_Profile_f
+
+profile [reset]
+================
+*/
+void Svcmd_Profile_f( void ) {
+	static int		sorted[ PROFILE_SAMPLES ];
+	profileScope_t	*scope;
+	char			arg[ MAX_TOKEN_CHARS ];
+	float			total;
+	int				i, j, p99;
+
+	trap_Argv( 1, arg, sizeof( arg ) );
+	if ( !Q_stricmp( arg, "reset" ) ) {
+		G_ProfileReset();
+		G_Printf( "Profile reset.\n" );
+		return;
+	}
+
+	if ( !g_profile.integer ) {
+		G_Printf( "Profiler is disabled, set g_profile 1 to enable it.\n" );
+	}
+
+	G_Printf( "Clock: %s, last %i samples per scope, times in usec\n",
+		hiResClock ? "microseconds" : "milliseconds", PROFILE_SAMPLES );
+	G_Printf( "%-18s %8s %8s %8s %8s %8s\n", "scope", "calls", "min", "avg", "p99", "max" );
+
+	for ( i = 0; i < PROF_NUM_SCOPES; i++ ) {
+		scope = &profileScopes[ i ];
+		if ( !scope->count ) {
+			G_Printf( "%-18s %8i\n", profileNames[ i ], 0 );
+			continue;
+		}
+
+		memcpy( sorted, scope->samples, scope->count * sizeof( sorted[0] ) );
+		qsort( sorted, scope->count, sizeof( sorted[0] ), G_ProfileCompare );
+
+		total = 0.0f;
+		for ( j = 0; j < scope->count; j++ ) {
+			total += sorted[ j ];
+		}
+		p99 = ( scope->count * 99 ) / 100;
+		if ( p99 >= scope->count ) {
+			p99 = scope->count - 1;
+		}
+
+		G_Printf( "%-18s %8i %8i %8i %8i %8i\n", profileNames[ i ], scope->calls,
+			sorted[ 0 ], (int)( total / scope->count ), sorted[ p99 ], sorted[ scope->count - 1 ] );
+	}
+
+	for ( i = 0; i < PCOUNT_NUM_COUNTERS; i++ ) {
+		G_Printf( "%-32s %8i\n", profileCounterNames[ i ], profileCounters[ i ] );
+	}
+}
@@ -0,0 +1,306 @@
+// Public Domain
+
+#include "g_local.h"
+
+/*
+=========================================================================
+
+usercmd recording
+
+With g_recordCmds 1 every map load writes records/<map>-<date>.ucmd with
+everything that reaches the game module from the outside: the random
+seed, the serverinfo and game cvars, the map entities, client connects,
+userinfo changes, client commands and every usercmd.  Feeding the file
+back in the same order (qabench -replay) plays the match again without
+any players online.
+
+All numbers are written little endian, strings as a 16 bit length
+followed by the characters.  Usercmds only store the fields that changed
+since the previous usercmd of the same client.
+
+=========================================================================
+*/
+
+#define RECORD_BUFFER		16384
+
+static fileHandle_t	recordFile = FS_INVALID_HANDLE;
+static byte			recordBuffer[ RECORD_BUFFER ];
+static int			recordLength;
+static int			recordTotal;
+static usercmd_t	recordLastCmd[ MAX_CLIENTS ];
+
+
+static void G_RecordFlush( void ) {
+	if ( recordLength ) {
+		trap_FS_Write( recordBuffer, recordLength, recordFile );
+		recordTotal += recordLength;
+		recordLength = 0;
+	}
+}
+
+
+static void G_RecordReserve( int size ) {
+	if ( recordLength + size > RECORD_BUFFER ) {
+		G_RecordFlush();
+	}
+}
+
+
+static void G_RecordByte( int value ) {
+	G_RecordReserve( 1 );
+	recordBuffer[ recordLength++ ] = value & 255;
+}
+
+
+static void G_RecordShort( int value ) {
+	G_RecordReserve( 2 );
+	recordBuffer[ recordLength++ ] = value & 255;
+	recordBuffer[ recordLength++ ] = ( value >> 8 ) & 255;
+}
+
+
+static void G_RecordInt( int value ) {
+	G_RecordReserve( 4 );
+	recordBuffer[ recordLength++ ] = value & 255;
+	recordBuffer[ recordLength++ ] = ( value >> 8 ) & 255;
+	recordBuffer[ recordLength++ ] = ( value >> 16 ) & 255;
+	recordBuffer[ recordLength++ ] = ( value >> 24 ) & 255;
+}
+
+
+static void G_RecordString( const char *s ) {
+	int len;
+
+	len = strlen( s );
+	G_RecordReserve( 2 + len );
+	G_RecordShort( len );
+	memcpy( recordBuffer + recordLength, s, len );
+	recordLength += len;
+}
+
+
+/*
+================
+G_RecordInit
+
+Called from G_InitGame before any entities are spawned
+================
+*/
+void G_RecordInit( int levelTime, int randomSeed ) {
+	char	serverinfo[ MAX_INFO_STRING ];
+	char	filename[ MAX_QPATH ];
+	qtime_t	t;
+
+	if ( !g_recordCmds.integer ) {
+		return;
+	}
+
+	trap_RealTime( &t );
+	Com_sprintf( filename, sizeof( filename ), "records/%s-%04i%02i%02i-%02i%02i%02i.ucmd",
+		g_mapname.string, t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec );
+
+	trap_FS_FOpenFile( filename, &recordFile, FS_WRITE );
+	if ( recordFile == FS_INVALID_HANDLE ) {
+		G_Printf( "WARNING: Couldn't open %s\n", filename );
+		return;
+	}
+
+	recordLength = 0;
+	recordTotal = 0;
+	memset( recordLastCmd, 0, sizeof( recordLastCmd ) );
+
+	trap_GetServerinfo( serverinfo, sizeof( serverinfo ) );
+
+	G_RecordInt( RECORD_MAGIC );
+	G_RecordInt( RECORD_VERSION );
+	G_RecordInt( levelTime );
+	G_RecordInt( randomSeed );
+	G_RecordInt( sv_fps.integer );
+	G_RecordString( serverinfo );
+
+	G_Printf( "Recording usercmds to %s\n", filename );
+}
+
+
+/*
+================
+G_RecordCvar
+
+Game cvars are written after the header, serverinfo alone
+misses things like g_warmup
+================
+*/
+void G_RecordCvar( const char *name ) {
+	char value[ MAX_CVAR_VALUE_STRING ];
+
+	if ( recordFile == FS_INVALID_HANDLE ) {
+		return;
+	}
+
+	trap_Cvar_VariableStringBuffer( name, value, sizeof( value ) );
+
+	G_RecordByte( REC_CVAR );
+	G_RecordString( name );
+	G_RecordString( value );
+}
+
+
+/*
+================
+G_RecordShutdown
+================
+*/
+void G_RecordShutdown( void ) {
+	if ( recordFile == FS_INVALID_HANDLE ) {
+		return;
+	}
+
+	G_RecordByte( REC_END );
+	G_RecordFlush();
+	trap_FS_FCloseFile( recordFile );
+	recordFile = FS_INVALID_HANDLE;
+
+	G_Printf( "Recorded %i bytes of usercmds\n", recordTotal );
+}
+
+
+/*
+================
+G_RecordSpawnVars
+
+The entity string isn't available to the game as a whole,
+so the key/value pairs are written as they are parsed
+================
+*/
+void G_RecordSpawnVars( void ) {
+	int i;
+
+	if ( recordFile == FS_INVALID_HANDLE ) {
+		return;
+	}
+
+	G_RecordByte( REC_SPAWN );
+	G_RecordByte( level.numSpawnVars );
+	for ( i = 0; i < level.numSpawnVars; i++ ) {
+		G_RecordString( level.spawnVars[i][0] );
+		G_RecordString( level.spawnVars[i][1] );
+	}
+}
+
+
+void G_RecordFrame( int levelTime ) {
+	if ( recordFile == FS_INVALID_HANDLE ) {
+		return;
+	}
+
+	G_RecordByte( REC_FRAME );
+	G_RecordInt( levelTime );
+}
+
+
+/*
+================
+G_RecordClient
+
+Connect, begin, userinfo and disconnect events
+================
+*/
+void G_RecordClient( recordType_t type, int clientNum, int arg0, int arg1 ) {
+	char userinfo[ MAX_INFO_STRING ];
+
+	if ( recordFile == FS_INVALID_HANDLE ) {
+		return;
+	}
+
+	G_RecordByte( type );
+	G_RecordByte( clientNum );
+
+	if ( type == REC_CONNECT ) {
+		G_RecordByte( arg0 );	// firstTime
+		G_RecordByte( arg1 );	// isBot
+		memset( &recordLastCmd[ clientNum ], 0, sizeof( recordLastCmd[0] ) );
+	}
+
+	if ( type == REC_CONNECT || type == REC_USERINFO ) {
+		trap_GetUserinfo( clientNum, userinfo, sizeof( userinfo ) );
+		G_RecordString( userinfo );
+	}
+}
+
+
+void G_RecordCommand( int clientNum ) {
+	char	arg[ MAX_TOKEN_CHARS ];
+	int		i, argc;
+
+	if ( recordFile == FS_INVALID_HANDLE ) {
+		return;
+	}
+
+	argc = trap_Argc();
+	if ( argc > 255 ) {
+		argc = 255;
+	}
+
+	G_RecordByte( REC_COMMAND );
+	G_RecordByte( clientNum );
+	G_RecordByte( argc );
+	for ( i = 0; i < argc; i++ ) {
+		trap_Argv( i, arg, sizeof( arg ) );
+		G_RecordString( arg );
+	}
+}
+
+
+/*
+================
+G_RecordUsercmd
+
+Written as a mask of the fields that changed followed by those fields
+================
+*/
+void G_RecordUsercmd( int clientNum, const usercmd_t *cmd ) {
+	usercmd_t	*last;
+	int			mask;
+
+	if ( recordFile == FS_INVALID_HANDLE ) {
+		return;
+	}
+
+	last = &recordLastCmd[ clientNum ];
+
+	mask = 0;
+	if ( cmd->angles[0] != last->angles[0] )
+		mask |= UCMD_PITCH;
+	if ( cmd->angles[1] != last->angles[1] )
+		mask |= UCMD_YAW;
+	if ( cmd->angles[2] != last->angles[2] )
+		mask |= UCMD_ROLL;
+	if ( cmd->buttons != last->buttons )
+		mask |= UCMD_BUTTONS;
+	if ( cmd->weapon != last->weapon )
+		mask |= UCMD_WEAPON;
+	if ( cmd->forwardmove != last->forwardmove || cmd->rightmove != last->rightmove || cmd->upmove != last->upmove )
+		mask |= UCMD_MOVE;
+
+	G_RecordByte( REC_USERCMD );
+	G_RecordByte( clientNum );
+	G_RecordByte( mask );
+	G_RecordInt( cmd->serverTime );
+	if ( mask & UCMD_PITCH )
+		G_RecordShort( cmd->angles[0] );
+	if ( mask & UCMD_YAW )
+		G_RecordShort( cmd->angles[1] );
+	if ( mask & UCMD_ROLL )
+		G_RecordShort( cmd->angles[2] );
+	if ( mask & UCMD_BUTTONS )
+		G_RecordInt( cmd->buttons );
+	if ( mask & UCMD_WEAPON )
+		G_RecordByte( cmd->weapon );
+	if ( mask & UCMD_MOVE ) {
+		G_RecordByte( cmd->forwardmove );
+		G_RecordByte( cmd->rightmove );
+		G_RecordByte( cmd->upmove );
+	}
+
+	*last = *cmd;
+}
@@ -58,6 +58,7 @@ typedef enum {
 	F_INT, 
 	F_FLOAT,
 	F_LSTRING,			// string on disk, pointer in memory, TAG_LEVEL
+	F_NAME,				// F_LSTRING matched ignoring case, see G_NewName
 	F_GSTRING,			// string on disk, pointer in memory, TAG_GAME
 	F_VECTOR,
 	F_ANGLEHACK,
@@ -82,8 +83,8 @@ const field_t fields[] = {
 	{"model2", FOFS(model2), F_LSTRING},
 	{"spawnflags", FOFS(spawnflags), F_INT},
 	{"speed", FOFS(speed), F_FLOAT},
-	{"target", FOFS(target), F_LSTRING},
-	{"targetname", FOFS(targetname), F_LSTRING},
+	{"target", FOFS(target), F_NAME},
+	{"targetname", FOFS(targetname), F_NAME},
 	{"message", FOFS(message), F_LSTRING},
 	{"team", FOFS(team), F_LSTRING},
 	{"wait", FOFS(wait), F_FLOAT},
@@ -249,6 +250,48 @@ spawn_t	spawns[] = {
 	{0, 0}
 };
 
+static qboolean	spawnsSorted;
+
+
+static int QDECL G_CompareSpawns( const void *a, const void *b ) {
+	return strcmp( ((const spawn_t *)a)->name, ((const spawn_t *)b)->name );
+}
+
+
+/*
+===============
+G_FindSpawn
+
+The spawn table is sorted by name the first time it is searched
+===============
+*/
+static const spawn_t *G_FindSpawn( const char *classname ) {
+	int		low, high, mid, c;
+
+	if ( !spawnsSorted ) {
+		qsort( spawns, ARRAY_LEN( spawns ) - 1, sizeof( spawns[0] ), G_CompareSpawns );
+		spawnsSorted = qtrue;
+	}
+
+	low = 0;
+	high = ARRAY_LEN( spawns ) - 2;
+	while ( low <= high ) {
+		mid = ( low + high ) >> 1;
+		c = strcmp( spawns[ mid ].name, classname );
+		if ( !c ) {
+			return &spawns[ mid ];
+		}
+		if ( c < 0 ) {
+			low = mid + 1;
+		} else {
+			high = mid - 1;
+		}
+	}
+
+	return NULL;
+}
+
+
 /*
 ===============
 G_CallSpawn
@@ -258,7 +301,7 @@ returning qfalse if not found
 ===============
 */
 qboolean G_CallSpawn( gentity_t *ent ) {
-	spawn_t	*s;
+	const spawn_t	*s;
 	gitem_t	*item;
 
 	if ( !ent->classname ) {
@@ -267,20 +310,18 @@ qboolean G_CallSpawn( gentity_t *ent ) {
 	}
 
 	// check item spawn functions
-	for ( item=bg_itemlist+1 ; item->classname ; item++ ) {
-		if ( !strcmp(item->classname, ent->classname) ) {
-			G_SpawnItem( ent, item );
-			return qtrue;
-		}
+	item = BG_FindItemByClassname( ent->classname );
+	if ( item ) {
+		G_SpawnItem( ent, item );
+		return qtrue;
 	}
 
 	// check normal spawn functions
-	for ( s=spawns ; s->name ; s++ ) {
-		if ( !strcmp(s->name, ent->classname) ) {
-			// found it
-			s->spawn(ent);
-			return qtrue;
-		}
+	s = G_FindSpawn( ent->classname );
+	if ( s ) {
+		// found it
+		s->spawn(ent);
+		return qtrue;
 	}
 	G_Printf ("%s doesn't have a spawn function\n", ent->classname);
 	return qfalse;
@@ -288,25 +329,25 @@ qboolean G_CallSpawn( gentity_t *ent ) {
 
 /*
 =============
-G_NewString
+G_TranslateString
 
-Builds a copy of the string, translating \n to real linefeeds
-so message texts can be multi-line
+Turns \n into real linefeeds so message texts can be multi-line
 =============
 */
-char *G_NewString( const char *string ) {
-	char	*newb, *new_p;
+static void G_TranslateString( const char *string, char *newb, int size ) {
+	char	*new_p;
 	int		i,l;
 	
 	l = (int)strlen(string) + 1;
-
-	newb = G_Alloc( l );
+	if ( l > size ) {
+		l = size;
+	}
 
 	new_p = newb;
 
 	// turn \n into a real linefeed
-	for ( i=0 ; i< l ; i++ ) {
-		if (string[i] == '\\' && i < l-1) {
+	for ( i=0 ; i< l-1 ; i++ ) {
+		if (string[i] == '\\' && i < l-2) {
 			i++;
 			if (string[i] == 'n') {
 				*new_p++ = '\n';
@@ -317,8 +358,38 @@ char *G_NewString( const char *string ) {
 			*new_p++ = string[i];
 		}
 	}
-	
-	return newb;
+	*new_p = '\0';
+}
+
+
+/*
+=============
+G_NewString
+
+Returns the interned copy of the string
+=============
+*/
+const char *G_NewString( const char *string ) {
+	char	newb[MAX_SPAWN_VARS_CHARS];
+
+	G_TranslateString( string, newb, sizeof( newb ) );
+	return G_InternString( newb );
+}
+
+
+/*
+=============
+G_NewName
+
+G_NewString for target names, all spellings of a name that only
+differ in case get the same pointer
+=============
+*/
+const char *G_NewName( const char *string ) {
+	char	newb[MAX_SPAWN_VARS_CHARS];
+
+	G_TranslateString( string, newb, sizeof( newb ) );
+	return G_InternName( newb );
 }
 
 
@@ -345,7 +416,10 @@ void G_ParseField( const char *key, const char *value, gentity_t *ent ) {
 
 			switch( f->type ) {
 			case F_LSTRING:
-				*(char **)(b+f->ofs) = G_NewString (value);
+				*(const char **)(b+f->ofs) = G_NewString (value);
+				break;
+			case F_NAME:
+				*(const char **)(b+f->ofs) = G_NewName (value);
 				break;
 			case F_VECTOR:
 				Q_sscanf (value, "%f %f %f", &vec[0], &vec[1], &vec[2]);
@@ -397,6 +471,7 @@ void G_SpawnGEntityFromSpawnVars( void ) {
 	for ( i = 0 ; i < level.numSpawnVars ; i++ ) {
 		G_ParseField( level.spawnVars[i][0], level.spawnVars[i][1], ent );
 	}
+	G_UpdateEntityNames( ent );
 
 	// check for "notsingle" flag
 	if ( g_gametype.integer == GT_SINGLE_PLAYER ) {
@@ -534,6 +609,8 @@ qboolean G_ParseSpawnVars( void ) {
 		level.numSpawnVars++;
 	}
 
+	G_RecordSpawnVars();
+
 	return qtrue;
 }
 
@@ -472,6 +472,21 @@ qboolean	ConsoleCommand( void ) {
 		return qtrue;
 	}
 
+	if (Q_stricmp (cmd, "g_entityStats") == 0) {
+		Svcmd_EntityStats_f();
+		return qtrue;
+	}
+
+	if (Q_stricmp (cmd, "g_configstringStats") == 0) {
+		Svcmd_ConfigstringStats_f();
+		return qtrue;
+	}
+
+	if (Q_stricmp (cmd, "profile") == 0) {
+		Svcmd_Profile_f();
+		return qtrue;
+	}
+
 	if (Q_stricmp (cmd, "addbot") == 0) {
 		Svcmd_AddBot_f();
 		return qtrue;
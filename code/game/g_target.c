@@ -21,7 +21,7 @@ void Use_Target_Give( gentity_t *ent, gentity_t *other, gentity_t *activator ) {
 
 	memset( &trace, 0, sizeof( trace ) );
 	t = NULL;
-	while ( (t = G_Find (t, FOFS(targetname), ent->target)) != NULL ) {
+	while ( (t = G_NextTarget (t, ent->target)) != NULL ) {
 		if ( !t->item ) {
 			continue;
 		}
@@ -29,7 +29,7 @@ void Use_Target_Give( gentity_t *ent, gentity_t *other, gentity_t *activator ) {
 
 		// make sure it isn't going to respawn or show any events
 		t->tag = TAG_DONTSPAWN;
-		t->nextthink = 0;
+		G_SetNextThink( t, 0 );
 		trap_UnlinkEntity( t );
 	}
 }
@@ -77,7 +77,7 @@ void Think_Target_Delay( gentity_t *ent ) {
 }
 
 void Use_Target_Delay( gentity_t *ent, gentity_t *other, gentity_t *activator ) {
-	ent->nextthink = level.time + ( ent->wait + ent->random * crandom() ) * 1000;
+	G_SetNextThink( ent, level.time + ( ent->wait + ent->random * crandom() ) * 1000 );
 	ent->think = Think_Target_Delay;
 	ent->activator = activator;
 }
@@ -225,7 +225,7 @@ void SP_target_speaker( gentity_t *ent ) {
 
 	// must link the entity so we get areas and clusters so
 	// the server can determine who to send updates to
-	trap_LinkEntity( ent );
+	G_LinkEntity( ent );
 }
 
 
@@ -261,8 +261,8 @@ void target_laser_think (gentity_t *self) {
 
 	VectorCopy (tr.endpos, self->s.origin2);
 
-	trap_LinkEntity( self );
-	self->nextthink = level.time + FRAMETIME;
+	G_LinkEntity( self );
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 
 void target_laser_on (gentity_t *self)
@@ -275,7 +275,7 @@ void target_laser_on (gentity_t *self)
 void target_laser_off (gentity_t *self)
 {
 	trap_UnlinkEntity( self );
-	self->nextthink = 0;
+	G_SetNextThink( self, 0 );
 }
 
 void target_laser_use (gentity_t *self, gentity_t *other, gentity_t *activator)
@@ -294,7 +294,7 @@ void target_laser_start (gentity_t *self)
 	self->s.eType = ET_BEAM;
 
 	if (self->target) {
-		ent = G_Find (NULL, FOFS(targetname), self->target);
+		ent = G_NextTarget (NULL, self->target);
 		if (!ent) {
 			G_Printf ("%s at %s: %s is a bad target\n", self->classname, vtos(self->s.origin), self->target);
 		}
@@ -320,7 +320,7 @@ void SP_target_laser (gentity_t *self)
 {
 	// let everything else get spawned before we start firing
 	self->think = target_laser_start;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 
 
@@ -434,6 +434,8 @@ static void target_location_linkup(gentity_t *ent)
 		}
 	}
 
+	Team_LinkLocations();
+
 	// All linked together now
 }
 
@@ -447,7 +449,7 @@ in site, closest in distance
 */
 void SP_target_location( gentity_t *self ){
 	self->think = target_location_linkup;
-	self->nextthink = level.time + 200;  // Let them all spawn first
+	G_SetNextThink( self, level.time + 200 );  // Let them all spawn first
 
 	G_SetOrigin( self, self->s.origin );
 }
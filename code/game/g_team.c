@@ -149,6 +149,7 @@ void AddTeamScore( vec3_t origin, team_t team, int score ) {
 	}
 
 	level.teamScores[ team ] += score;
+	G_InvalidateScoreboard();
 }
 
 /*
@@ -909,42 +910,202 @@ int Pickup_Team( gentity_t *ent, gentity_t *other ) {
 }
 
 
+/*
+=========================================================================
+
+target_location grid
+
+The locations are put into a 2D grid so that a lookup can visit them
+nearest first and stop at the first one in the PVS, instead of doing an
+InPVS test for every location closer than the best so far.
+
+=========================================================================
+*/
+
+#define LOCATION_GRID_SIZE		16
+#define LOCATION_MAX_DIST		( 3*8192.0*8192.0 )
+#define LOCATION_CACHE_DIST		32		// reuse the last location within this
+
+static gentity_t	*locationCells[ LOCATION_GRID_SIZE * LOCATION_GRID_SIZE ];
+static gentity_t	*locationCellNext[ MAX_GENTITIES ];
+static vec2_t		locationMins;
+static float		locationCellSize;
+
+// lookup candidates, farthest first
+static gentity_t	*locationCands[ MAX_GENTITIES ];
+static float		locationCandDist[ MAX_GENTITIES ];
+static int			numLocationCands;
+
+
+static int Team_LocationCell( float v, int axis ) {
+	int c;
+
+	c = (int)( ( v - locationMins[ axis ] ) / locationCellSize );
+	if ( c < 0 )
+		return 0;
+	if ( c >= LOCATION_GRID_SIZE )
+		return LOCATION_GRID_SIZE - 1;
+	return c;
+}
+
+
 /*
 ===========
-Team_GetLocation
+Team_LinkLocations
 
-Report a location for the player. Uses placed nearby target_location entities
+Called once level.locationHead is complete
 ============
 */
-gentity_t *Team_GetLocation(gentity_t *ent)
-{
-	gentity_t		*eloc, *best;
-	float			bestlen, len;
-	vec3_t			origin;
+void Team_LinkLocations( void ) {
+	gentity_t	*eloc;
+	vec2_t		maxs;
+	float		size;
+	int			cell;
+
+	memset( locationCells, 0, sizeof( locationCells ) );
+
+	if ( !level.locationHead )
+		return;
 
-	best = NULL;
-	bestlen = 3*8192.0*8192.0;
+	locationMins[0] = maxs[0] = level.locationHead->r.currentOrigin[0];
+	locationMins[1] = maxs[1] = level.locationHead->r.currentOrigin[1];
+	for ( eloc = level.locationHead; eloc; eloc = eloc->nextTrain ) {
+		if ( eloc->r.currentOrigin[0] < locationMins[0] ) locationMins[0] = eloc->r.currentOrigin[0];
+		if ( eloc->r.currentOrigin[1] < locationMins[1] ) locationMins[1] = eloc->r.currentOrigin[1];
+		if ( eloc->r.currentOrigin[0] > maxs[0] ) maxs[0] = eloc->r.currentOrigin[0];
+		if ( eloc->r.currentOrigin[1] > maxs[1] ) maxs[1] = eloc->r.currentOrigin[1];
+	}
+
+	size = maxs[0] - locationMins[0];
+	if ( maxs[1] - locationMins[1] > size )
+		size = maxs[1] - locationMins[1];
+	locationCellSize = size / LOCATION_GRID_SIZE + 1.0f;
 
-	VectorCopy( ent->r.currentOrigin, origin );
+	for ( eloc = level.locationHead; eloc; eloc = eloc->nextTrain ) {
+		cell = Team_LocationCell( eloc->r.currentOrigin[1], 1 ) * LOCATION_GRID_SIZE
+			+ Team_LocationCell( eloc->r.currentOrigin[0], 0 );
+		locationCellNext[ eloc - g_entities ] = locationCells[ cell ];
+		locationCells[ cell ] = eloc;
+	}
+}
 
-	for (eloc = level.locationHead; eloc; eloc = eloc->nextTrain) {
+
+/*
+===========
+Team_AddLocationCands
+
+Adds all locations of a cell to the candidates, keeping them ordered
+by distance and then entity number, the nearest and on a tie the lowest
+numbered last, which is the one the old list walk settled on
+============
+*/
+static void Team_AddLocationCands( const vec3_t origin, int x, int y ) {
+	gentity_t	*eloc;
+	float		len;
+	int			i;
+
+	if ( x < 0 || y < 0 || x >= LOCATION_GRID_SIZE || y >= LOCATION_GRID_SIZE )
+		return;
+
+	for ( eloc = locationCells[ y * LOCATION_GRID_SIZE + x ]; eloc; eloc = locationCellNext[ eloc - g_entities ] ) {
 		len = ( origin[0] - eloc->r.currentOrigin[0] ) * ( origin[0] - eloc->r.currentOrigin[0] )
 			+ ( origin[1] - eloc->r.currentOrigin[1] ) * ( origin[1] - eloc->r.currentOrigin[1] )
 			+ ( origin[2] - eloc->r.currentOrigin[2] ) * ( origin[2] - eloc->r.currentOrigin[2] );
 
-		if ( len > bestlen ) {
+		if ( len > LOCATION_MAX_DIST )
 			continue;
+
+		for ( i = numLocationCands; i > 0; i-- ) {
+			if ( locationCandDist[ i-1 ] > len || ( locationCandDist[ i-1 ] == len && locationCands[ i-1 ] > eloc ) )
+				break;
+			locationCands[ i ] = locationCands[ i-1 ];
+			locationCandDist[ i ] = locationCandDist[ i-1 ];
 		}
+		locationCands[ i ] = eloc;
+		locationCandDist[ i ] = len;
+		numLocationCands++;
+	}
+}
 
-		if ( !trap_InPVS( origin, eloc->r.currentOrigin ) ) {
-			continue;
+
+/*
+===========
+Team_FindLocation
+
+Visits the grid in rings around the origin.  Everything outside of ring r
+is at least r cells away, so the candidates closer than that are tested
+nearest first and the first one in the PVS is the answer.
+============
+*/
+static gentity_t *Team_FindLocation( const vec3_t origin ) {
+	gentity_t	*eloc;
+	float		bound;
+	int			cx, cy, r, i;
+
+	if ( !level.locationHead )
+		return NULL;
+
+	cx = Team_LocationCell( origin[0], 0 );
+	cy = Team_LocationCell( origin[1], 1 );
+	numLocationCands = 0;
+
+	for ( r = 0; r < LOCATION_GRID_SIZE; r++ ) {
+		if ( r == 0 ) {
+			Team_AddLocationCands( origin, cx, cy );
+		} else {
+			for ( i = -r; i <= r; i++ ) {
+				Team_AddLocationCands( origin, cx + i, cy - r );
+				Team_AddLocationCands( origin, cx + i, cy + r );
+			}
+			for ( i = -r + 1; i <= r - 1; i++ ) {
+				Team_AddLocationCands( origin, cx - r, cy + i );
+				Team_AddLocationCands( origin, cx + r, cy + i );
+			}
 		}
 
-		bestlen = len;
-		best = eloc;
+		bound = r * locationCellSize;
+		bound *= bound;
+
+		while ( numLocationCands > 0 ) {
+			// a location in the next ring could still be as close
+			if ( r < LOCATION_GRID_SIZE - 1 && locationCandDist[ numLocationCands-1 ] >= bound )
+				break;
+			eloc = locationCands[ --numLocationCands ];
+			if ( trap_InPVS( origin, eloc->r.currentOrigin ) )
+				return eloc;
+		}
 	}
 
-	return best;
+	return NULL;
+}
+
+
+/*
+===========
+Team_GetLocation
+
+Report a location for the player. Uses placed nearby target_location entities
+============
+*/
+gentity_t *Team_GetLocation(gentity_t *ent)
+{
+	playerTeamState_t	*ts;
+	vec3_t				delta;
+
+	if ( !ent->client )
+		return Team_FindLocation( ent->r.currentOrigin );
+
+	ts = &ent->client->pers.teamState;
+	VectorSubtract( ent->r.currentOrigin, ts->lastLocationOrigin, delta );
+	if ( ts->lastLocationValid && VectorLengthSquared( delta ) < LOCATION_CACHE_DIST * LOCATION_CACHE_DIST ) {
+		return ts->lastLocation;
+	}
+
+	ts->lastLocation = Team_FindLocation( ent->r.currentOrigin );
+	ts->lastLocationValid = qtrue;
+	VectorCopy( ent->r.currentOrigin, ts->lastLocationOrigin );
+
+	return ts->lastLocation;
 }
 
 
@@ -1064,74 +1225,119 @@ gentity_t *SelectCTFSpawnPoint( gentity_t *ent, team_t team, int teamstate, vec3
 
 /*---------------------------------------------------------------------------*/
 
-static int QDECL SortClients( const void *a, const void *b ) {
-	return *(int *)a - *(int *)b;
-}
+// team overlay payloads, built once per update for all members of a team
+typedef struct {
+	char	string[ MAX_STRING_CHARS - 9 ]; // -strlen("tinfo nn ")
+	int		length;
+	int		count;
+	int		id;				// changes whenever the payload does
+} teamInfo_t;
+
+static teamInfo_t	teamInfo[ TEAM_NUM_TEAMS ];
+static int			teamInfoNextId;
+
+#define TEAM_INFO_REFRESH_TIME	10000	// resend unchanged payloads this often
 
 
 /*
 ==================
-TeamplayLocationsMessage
+Team_BuildInfoMessages
 
 Format:
 	clientNum location health armor weapon powerups
 
+The first TEAM_MAXOVERLAY team members in client order are listed,
+so they don't keep changing position on the overlay
 ==================
 */
-void TeamplayInfoMessage( gentity_t *ent ) {
+static void Team_BuildInfoMessages( void ) {
 	char		entry[ 128 ]; // to fit 6 decimal numbers with spaces
-	char		string[ MAX_STRING_CHARS - 9 ]; // -strlen("tinfo nn ")
-	int			stringlength;
-	int			i, j;
+	teamInfo_t	next[ TEAM_NUM_TEAMS ];
+	qboolean	full[ TEAM_NUM_TEAMS ];
+	teamInfo_t	*info;
 	gentity_t	*player;
-	int			cnt;
+	int			i, j, t;
 	int			h, a;
-	int			clients[TEAM_MAXOVERLAY];
 
-	if ( !ent->client->pers.teamInfo )
-		return;
+	full[ TEAM_RED ] = full[ TEAM_BLUE ] = qfalse;
+	next[ TEAM_RED ].length = next[ TEAM_BLUE ].length = 0;
+	next[ TEAM_RED ].count = next[ TEAM_BLUE ].count = 0;
+	next[ TEAM_RED ].string[0] = next[ TEAM_BLUE ].string[0] = '\0';
 
-	// figure out what client should be on the display
-	// we are limited to 8, but we want to use the top eight players
-	// but in client order (so they don't keep changing position on the overlay)
-	for (i = 0, cnt = 0; i < level.maxclients && cnt < TEAM_MAXOVERLAY; i++) {
-		player = g_entities + level.sortedClients[i];
-		if (player->inuse && player->client->sess.sessionTeam ==
-			ent->client->sess.sessionTeam ) {
-			clients[cnt++] = level.sortedClients[i];
-		}
-	}
+	for ( i = 0; i < level.maxclients; i++ ) {
+		player = g_entities + i;
+		if ( !player->inuse )
+			continue;
+
+		t = player->client->sess.sessionTeam;
+		if ( t != TEAM_RED && t != TEAM_BLUE )
+			continue;
 
-	// We have the top eight players, sort them by clientNum
-	qsort( clients, cnt, sizeof( clients[0] ), SortClients );
+		info = &next[ t ];
+		if ( full[ t ] || info->count >= TEAM_MAXOVERLAY )
+			continue;
 
-	// send the latest information on all clients
-	string[0] = '\0';
-	stringlength = 0;
+		h = player->client->ps.stats[STAT_HEALTH];
+		a = player->client->ps.stats[STAT_ARMOR];
+		if (h < 0) h = 0;
+		if (a < 0) a = 0;
 
-	for (i = 0, cnt = 0; i < level.maxclients && cnt < TEAM_MAXOVERLAY; i++) {
-		player = g_entities + i;
-		if ( player->inuse && player->client->sess.sessionTeam ==
-			ent->client->sess.sessionTeam ) {
-
-			h = player->client->ps.stats[STAT_HEALTH];
-			a = player->client->ps.stats[STAT_ARMOR];
-			if (h < 0) h = 0;
-			if (a < 0) a = 0;
-
-			j = BG_sprintf( entry, " %i %i %i %i %i %i",
-//				level.sortedClients[i], player->client->pers.teamState.location, h, a, 
-				i, player->client->pers.teamState.location, h, a, 
-				player->client->ps.weapon, player->s.powerups);
-			if ( stringlength + j >= sizeof( string ) )
-				break;
-			strcpy( string + stringlength, entry );
-			stringlength += j;
-			cnt++;
+		j = BG_sprintf( entry, " %i %i %i %i %i %i",
+			i, player->client->pers.teamState.location, h, a, 
+			player->client->ps.weapon, player->s.powerups);
+		if ( info->length + j >= sizeof( info->string ) ) {
+			full[ t ] = qtrue;
+			continue;
 		}
+		strcpy( info->string + info->length, entry );
+		info->length += j;
+		info->count++;
+	}
+
+	for ( t = TEAM_RED; t <= TEAM_BLUE; t++ ) {
+		info = &teamInfo[ t ];
+		if ( info->id && info->length == next[ t ].length && !strcmp( info->string, next[ t ].string ) )
+			continue;
+
+		memcpy( info->string, next[ t ].string, next[ t ].length + 1 );
+		info->length = next[ t ].length;
+		info->count = next[ t ].count;
+		info->id = ++teamInfoNextId;
 	}
+}
+
+
+/*
+==================
+TeamplayInfoMessage
 
-	trap_SendServerCommand( ent-g_entities, va( "tinfo %i %s", cnt, string ) );
+Sends the current payload of the client's team, unless the
+client already has exactly that one
+==================
+*/
+void TeamplayInfoMessage( gentity_t *ent ) {
+	gclient_t	*client;
+	teamInfo_t	*info;
+	team_t		team;
+
+	client = ent->client;
+	if ( !client->pers.teamInfo )
+		return;
+
+	team = client->sess.sessionTeam;
+	if ( team != TEAM_RED && team != TEAM_BLUE )
+		return;
+
+	info = &teamInfo[ team ];
+
+	// cgame doesn't tell about vid_restart, so refresh now and then
+	if ( client->pers.teamInfoId == info->id && level.time - client->pers.teamInfoTime < TEAM_INFO_REFRESH_TIME )
+		return;
+
+	client->pers.teamInfoId = info->id;
+	client->pers.teamInfoTime = level.time;
+
+	trap_SendServerCommand( ent-g_entities, va( "tinfo %i %s", info->count, info->string ) );
 }
 
 
@@ -1159,6 +1365,8 @@ void CheckTeamStatus( void ) {
 			}
 		}
 
+		Team_BuildInfoMessages();
+
 		for (i = 0; i < level.maxclients; i++) {
 			ent = g_entities + i;
 
@@ -1212,7 +1420,7 @@ Obelisks
 */
 
 static void ObeliskRegen( gentity_t *self ) {
-	self->nextthink = level.time + g_obeliskRegenPeriod.integer * 1000;
+	G_SetNextThink( self, level.time + g_obeliskRegenPeriod.integer * 1000 );
 	if( self->health >= g_obeliskHealth.integer ) {
 		return;
 	}
@@ -1230,10 +1438,11 @@ static void ObeliskRegen( gentity_t *self ) {
 
 static void ObeliskRespawn( gentity_t *self ) {
 	self->takedamage = qtrue;
+	G_AddDamageable( self );
 	self->health = g_obeliskHealth.integer;
 
 	self->think = ObeliskRegen;
-	self->nextthink = level.time + g_obeliskRegenPeriod.integer * 1000;
+	G_SetNextThink( self, level.time + g_obeliskRegenPeriod.integer * 1000 );
 
 	self->activator->s.frame = 0;
 }
@@ -1250,7 +1459,7 @@ static void ObeliskDie( gentity_t *self, gentity_t *inflictor, gentity_t *attack
 
 	self->takedamage = qfalse;
 	self->think = ObeliskRespawn;
-	self->nextthink = level.time + g_obeliskRespawnDelay.integer * 1000;
+	G_SetNextThink( self, level.time + g_obeliskRespawnDelay.integer * 1000 );
 
 	self->activator->s.modelindex2 = 0xff;
 	self->activator->s.frame = 2;
@@ -1339,11 +1548,12 @@ gentity_t *SpawnObelisk( vec3_t origin, int team, int spawnflags) {
 	if( g_gametype.integer == GT_OBELISK ) {
 		ent->r.contents = CONTENTS_SOLID;
 		ent->takedamage = qtrue;
+		G_AddDamageable( ent );
 		ent->health = g_obeliskHealth.integer;
 		ent->die = ObeliskDie;
 		ent->pain = ObeliskPain;
 		ent->think = ObeliskRegen;
-		ent->nextthink = level.time + g_obeliskRegenPeriod.integer * 1000;
+		G_SetNextThink( ent, level.time + g_obeliskRegenPeriod.integer * 1000 );
 	}
 	if( g_gametype.integer == GT_HARVESTER ) {
 		ent->r.contents = CONTENTS_TRIGGER;
@@ -1377,7 +1587,7 @@ gentity_t *SpawnObelisk( vec3_t origin, int team, int spawnflags) {
 
 	ent->spawnflags = team;
 
-	trap_LinkEntity( ent );
+	G_LinkEntity( ent );
 
 	return ent;
 }
@@ -1404,7 +1614,7 @@ void SP_team_redobelisk( gentity_t *ent ) {
 		obelisk->activator = ent;
 	}
 	ent->s.modelindex = TEAM_RED;
-	trap_LinkEntity(ent);
+	G_LinkEntity(ent);
 }
 
 /*QUAKED team_blueobelisk (0 0 1) (-16 -16 0) (16 16 88)
@@ -1429,7 +1639,7 @@ void SP_team_blueobelisk( gentity_t *ent ) {
 		obelisk->activator = ent;
 	}
 	ent->s.modelindex = TEAM_BLUE;
-	trap_LinkEntity(ent);
+	G_LinkEntity(ent);
 }
 
 /*QUAKED team_neutralobelisk (0 0 1) (-16 -16 0) (16 16 88)
@@ -1445,7 +1655,7 @@ void SP_team_neutralobelisk( gentity_t *ent ) {
 		neutralObelisk->spawnflags = TEAM_FREE;
 	}
 	ent->s.modelindex = TEAM_FREE;
-	trap_LinkEntity(ent);
+	G_LinkEntity(ent);
 }
 
 
@@ -4,6 +4,52 @@
 
 #include "g_local.h"
 
+/*
+============
+G_HistoryIndex
+
+Ring index of the record "age" records older than the head
+============
+*/
+static int G_HistoryIndex( const clientHistory_t *history, int age ) {
+	int i;
+
+	i = history->head - age;
+	if ( i < 0 ) {
+		i += level.historySize;
+	}
+
+	return i;
+}
+
+
+/*
+============
+G_FindHistoryAge
+
+Binary search for the most recent record at or before "time",
+returns level.historySize if all records are newer
+============
+*/
+static int G_FindHistoryAge( const clientHistory_t *history, int time ) {
+	int		lo, hi, mid;
+
+	// record times decrease with age
+	lo = 0;
+	hi = level.historySize;
+	while ( lo < hi ) {
+		mid = ( lo + hi ) >> 1;
+		if ( history->leveltime[ G_HistoryIndex( history, mid ) ] <= time ) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+
+	return lo;
+}
+
+
 /*
 ============
 G_ResetHistory
@@ -13,18 +59,52 @@ Clear out the given client's history (should be called when the teleport bit is
 */
 void G_ResetHistory( gentity_t *ent ) {
 	int		i, t, dt;
-	gclient_t	*client;
+	clientHistory_t	*history;
 
-	client = ent->client;
+	history = &ent->client->history;
 	dt = 1000 / sv_fps.integer;
 
 	// fill up the history with data (assume the current position)
-	client->historyHead = NUM_CLIENT_HISTORY - 1;
-	for ( i = client->historyHead, t = level.time; i >= 0; i--, t -= dt ) {
-		VectorCopy( ent->r.mins, client->history[i].mins );
-		VectorCopy( ent->r.maxs, client->history[i].maxs );
-		VectorCopy( ent->r.currentOrigin, client->history[i].currentOrigin );
-		client->history[ i ].leveltime = t;
+	history->head = level.historySize - 1;
+	for ( i = history->head, t = level.time; i >= 0; i--, t -= dt ) {
+		VectorCopy( ent->r.mins, history->mins[i] );
+		VectorCopy( ent->r.maxs, history->maxs[i] );
+		VectorCopy( ent->r.currentOrigin, history->currentOrigin[i] );
+		history->leveltime[i] = t;
+	}
+}
+
+
+/*
+============
+G_UpdateHistorySize
+
+Size the history ring to cover g_unlaggedMaxMs at the current sv_fps,
+every client history is reset when it changes
+============
+*/
+void G_UpdateHistorySize( void ) {
+	int		size, i;
+	gentity_t	*ent;
+
+	size = g_unlaggedMaxMs.integer * sv_fps.integer / 1000 + 1;
+	if ( size < 2 ) {
+		size = 2;
+	} else if ( size > MAX_CLIENT_HISTORY ) {
+		size = MAX_CLIENT_HISTORY;
+	}
+
+	if ( size == level.historySize ) {
+		return;
+	}
+
+	level.historySize = size;
+
+	ent = &g_entities[0];
+	for ( i = 0; i < level.maxclients; i++, ent++ ) {
+		if ( ent->inuse && ent->client ) {
+			G_ResetHistory( ent );
+		}
 	}
 }
 
@@ -38,22 +118,25 @@ Keep track of where the client's been
 */
 void G_StoreHistory( gentity_t *ent ) {
 	int		head;
-	gclient_t	*client;
+	clientHistory_t	*history;
 
-	client = ent->client;
+	history = &ent->client->history;
 
-	client->historyHead++;
-	if ( client->historyHead >= NUM_CLIENT_HISTORY ) {
-		client->historyHead = 0;
+	// keep record times unique, so the sandwich never has zero length
+	if ( history->leveltime[ history->head ] != level.time ) {
+		history->head++;
+		if ( history->head >= level.historySize ) {
+			history->head = 0;
+		}
 	}
 
-	head = client->historyHead;
+	head = history->head;
 
 	// store all the collision-detection info and the time
-	VectorCopy( ent->r.mins, client->history[head].mins );
-	VectorCopy( ent->r.maxs, client->history[head].maxs );
-	VectorCopy( ent->s.pos.trBase, client->history[head].currentOrigin );
-	client->history[head].leveltime = level.time;
+	VectorCopy( ent->r.mins, history->mins[head] );
+	VectorCopy( ent->r.maxs, history->maxs[head] );
+	VectorCopy( ent->s.pos.trBase, history->currentOrigin[head] );
+	history->leveltime[head] = level.time;
 }
 
 
@@ -80,62 +163,58 @@ Move a client back to where he was at the specified "time"
 =================
 */
 void G_TimeShiftClient( gentity_t *ent, int time, qboolean debug, gentity_t *debugger ) {
-	int		j, k;
+	int		age, j, k;
 	gclient_t	*client;
+	clientHistory_t	*history;
 
-	// find two entries in the history whose times sandwich "time"
-	// assumes no two adjacent records have the same timestamp
 	client = ent->client;
-	j = k = client->historyHead;
-	do {
-		if ( client->history[j].leveltime <= time )
-			break;
+	history = &client->history;
 
-		k = j;
-		j--;
-		if ( j < 0 ) {
-			j = NUM_CLIENT_HISTORY - 1;
-		}
+	// find two entries in the history whose times sandwich "time"
+	age = G_FindHistoryAge( history, time );
+
+	// nothing to do if the most recent record is old enough
+	if ( age == 0 ) {
+		return;
+	}
+
+	// make sure it doesn't get re-saved
+	if ( client->saved.leveltime != level.time ) {
+		// save the current origin and bounding box
+		VectorCopy( ent->r.mins, client->saved.mins );
+		VectorCopy( ent->r.maxs, client->saved.maxs );
+		VectorCopy( ent->r.currentOrigin, client->saved.currentOrigin );
+		client->saved.leveltime = level.time;
 	}
-	while ( j != client->historyHead );
-
-	// if we got past the first iteration above, we've sandwiched (or wrapped)
-	if ( j != k ) {
-		// make sure it doesn't get re-saved
-		if ( client->saved.leveltime != level.time ) {
-			// save the current origin and bounding box
-			VectorCopy( ent->r.mins, client->saved.mins );
-			VectorCopy( ent->r.maxs, client->saved.maxs );
-			VectorCopy( ent->r.currentOrigin, client->saved.currentOrigin );
-			client->saved.leveltime = level.time;
-		}
 
-		// if we haven't wrapped back to the head, we've sandwiched, so
-		// we shift the client's position back to where he was at "time"
-		if ( j != client->historyHead ) {
-			float	frac = (float)(time - client->history[j].leveltime) /
-				(float)(client->history[k].leveltime - client->history[j].leveltime);
+	if ( age < level.historySize ) {
+		// we've sandwiched, so we shift the client's position back to where he was at "time"
+		float	frac;
 
-			// interpolate between the two origins to give position at time index "time"
-			TimeShiftLerp( frac, client->history[j].currentOrigin, client->history[k].currentOrigin, ent->r.currentOrigin );
+		j = G_HistoryIndex( history, age );
+		k = G_HistoryIndex( history, age - 1 );
 
-			// lerp these too, just for fun (and ducking)
-			TimeShiftLerp( frac, client->history[j].mins, client->history[k].mins, ent->r.mins );
+		frac = (float)(time - history->leveltime[j]) /
+			(float)(history->leveltime[k] - history->leveltime[j]);
 
-			TimeShiftLerp( frac, client->history[j].maxs, client->history[k].maxs,ent->r.maxs );
+		// interpolate between the two origins to give position at time index "time"
+		TimeShiftLerp( frac, history->currentOrigin[j], history->currentOrigin[k], ent->r.currentOrigin );
 
-			// this will recalculate absmin and absmax
-			trap_LinkEntity( ent );
-		} else {
-			// we wrapped, so grab the earliest
-			VectorCopy( client->history[k].currentOrigin, ent->r.currentOrigin );
-			VectorCopy( client->history[k].mins, ent->r.mins );
-			VectorCopy( client->history[k].maxs, ent->r.maxs );
+		// lerp these too, just for fun (and ducking)
+		TimeShiftLerp( frac, history->mins[j], history->mins[k], ent->r.mins );
 
-			// this will recalculate absmin and absmax
-			trap_LinkEntity( ent );
-		}
+		TimeShiftLerp( frac, history->maxs[j], history->maxs[k], ent->r.maxs );
+	} else {
+		// all records are newer, so grab the earliest
+		k = G_HistoryIndex( history, level.historySize - 1 );
+
+		VectorCopy( history->currentOrigin[k], ent->r.currentOrigin );
+		VectorCopy( history->mins[k], ent->r.mins );
+		VectorCopy( history->maxs[k], ent->r.maxs );
 	}
+
+	// this will recalculate absmin and absmax
+	G_LinkEntity( ent );
 }
 
 
@@ -167,14 +246,258 @@ void G_TimeShiftAllClients( int ltime, gentity_t *skip ) {
 }
 
 
+/*
+=========================================================================
+
+broadphase culling
+
+Clients that can't possibly be touched by a shot or a missile are not
+time shifted at all, which saves two relinks per client.  A client is
+tested with the bounds of everywhere it has been since the shift time,
+so a shot that misses them in the past also misses them in the present.
+
+=========================================================================
+*/
+
+#define MISSILE_SWEEP_EPSILON	8	// covers gravity arcs over a frame
+
+static int		numShifted;		// g_debugUnlagged counters
+static int		numSkipped;
+static int		debugTime;
+
+
+/*
+=================
+G_CountTimeShifts
+=================
+*/
+static void G_CountTimeShifts( int shifted, int skipped ) {
+	numShifted += shifted;
+	numSkipped += skipped;
+
+	if ( !g_debugUnlagged.integer ) {
+		return;
+	}
+
+	if ( level.time - debugTime >= 1000 ) {
+		G_Printf( "unlagged: %i clients shifted, %i skipped\n", numShifted, numSkipped );
+		numShifted = 0;
+		numSkipped = 0;
+		debugTime = level.time;
+	}
+}
+
+
+/*
+=================
+G_HistoryBounds
+
+Absolute bounds of everywhere the client has been since "time",
+including the current position
+=================
+*/
+static void G_HistoryBounds( gentity_t *ent, int time, vec3_t mins, vec3_t maxs ) {
+	clientHistory_t	*history;
+	vec3_t			point;
+	int				i, age, oldest;
+
+	history = &ent->client->history;
+
+	VectorCopy( ent->r.absmin, mins );
+	VectorCopy( ent->r.absmax, maxs );
+
+	// include the older end of the sandwich
+	oldest = G_FindHistoryAge( history, time );
+	if ( oldest >= level.historySize ) {
+		oldest = level.historySize - 1;
+	}
+
+	for ( age = 0; age <= oldest; age++ ) {
+		i = G_HistoryIndex( history, age );
+
+		VectorAdd( history->currentOrigin[i], history->mins[i], point );
+		AddPointToBounds( point, mins, maxs );
+		VectorAdd( history->currentOrigin[i], history->maxs[i], point );
+		AddPointToBounds( point, mins, maxs );
+	}
+}
+
+
+/*
+=================
+G_BoundsTouchShot
+
+Conservative test of bounds against a shot from "start" to "end" whose
+spread cone has the radius "spread" at "end"
+=================
+*/
+static qboolean G_BoundsTouchShot( const vec3_t mins, const vec3_t maxs, const vec3_t start, const vec3_t end, float spread ) {
+	vec3_t	center, dir, delta;
+	float	radius, length, t;
+
+	// bounding sphere of the box
+	VectorAdd( mins, maxs, center );
+	VectorScale( center, 0.5f, center );
+	VectorSubtract( maxs, center, delta );
+	radius = VectorLength( delta );
+
+	VectorSubtract( end, start, dir );
+	length = VectorNormalize( dir );
+
+	// closest point on the shot line
+	VectorSubtract( center, start, delta );
+	t = DotProduct( delta, dir );
+	if ( t < 0 ) {
+		t = 0;
+	} else if ( t > length ) {
+		t = length;
+	}
+	VectorMA( delta, -t, dir, delta );
+
+	if ( length > 0 ) {
+		radius += spread * t / length;
+	}
+
+	return DotProduct( delta, delta ) <= radius * radius;
+}
+
+
+/*
+=====================
+G_TimeShiftClientsForShot
+
+Move all clients that can be hit by the shot back to where they were
+at the specified "ltime", except for "skip"
+=====================
+*/
+static void G_TimeShiftClientsForShot( int ltime, gentity_t *skip, const vec3_t start, const vec3_t end, float spread ) {
+	int			i, shifted, skipped;
+	gentity_t	*ent;
+	vec3_t		mins, maxs;
+
+	shifted = skipped = 0;
+
+	ent = &g_entities[0];
+	for ( i = 0; i < level.maxclients; i++, ent++ ) {
+		if ( ent == skip )
+			continue;
+
+		if ( !ent->r.linked )
+			continue;
+
+		if ( !ent->client || !ent->inuse || ent->client->sess.sessionTeam >= TEAM_SPECTATOR )
+			continue;
+
+		G_HistoryBounds( ent, ltime, mins, maxs );
+		if ( !G_BoundsTouchShot( mins, maxs, start, end, spread ) ) {
+			skipped++;
+			continue;
+		}
+
+		G_TimeShiftClient( ent, ltime, qfalse, skip );
+		shifted++;
+	}
+
+	G_CountTimeShifts( shifted, skipped );
+}
+
+
+/*
+=====================
+G_TimeShiftClientsForMissiles
+
+Move all clients that can be touched by any of the missiles during this
+frame back to where they were at the specified "ltime"
+=====================
+*/
+void G_TimeShiftClientsForMissiles( int ltime, gentity_t **missiles, int numMissiles ) {
+	static vec3_t	missileMins[ MAX_GENTITIES ];
+	static vec3_t	missileMaxs[ MAX_GENTITIES ];
+	int			i, j, shifted, skipped;
+	gentity_t	*ent, *missile;
+	vec3_t		origin, mins, maxs;
+	float		pad;
+
+	if ( !g_unlaggedBroadphase.integer ) {
+		G_TimeShiftAllClients( ltime, NULL );
+		return;
+	}
+
+	// swept bounds of each missile for this frame, including splash
+	for ( i = 0; i < numMissiles; i++ ) {
+		missile = missiles[i];
+		BG_EvaluateTrajectory( &missile->s.pos, level.time, origin );
+		ClearBounds( missileMins[i], missileMaxs[i] );
+		AddPointToBounds( missile->r.currentOrigin, missileMins[i], missileMaxs[i] );
+		AddPointToBounds( origin, missileMins[i], missileMaxs[i] );
+		VectorAdd( missileMins[i], missile->r.mins, missileMins[i] );
+		VectorAdd( missileMaxs[i], missile->r.maxs, missileMaxs[i] );
+		pad = missile->splashRadius + MISSILE_SWEEP_EPSILON;
+		for ( j = 0; j < 3; j++ ) {
+			missileMins[i][j] -= pad;
+			missileMaxs[i][j] += pad;
+		}
+	}
+
+	shifted = skipped = 0;
+
+	ent = &g_entities[0];
+	for ( i = 0; i < level.maxclients; i++, ent++ ) {
+		if ( !ent->r.linked )
+			continue;
+
+		if ( !ent->client || !ent->inuse || ent->client->sess.sessionTeam >= TEAM_SPECTATOR )
+			continue;
+
+		G_HistoryBounds( ent, ltime, mins, maxs );
+		for ( j = 0; j < numMissiles; j++ ) {
+			if ( mins[0] > missileMaxs[j][0] || mins[1] > missileMaxs[j][1] || mins[2] > missileMaxs[j][2]
+				|| maxs[0] < missileMins[j][0] || maxs[1] < missileMins[j][1] || maxs[2] < missileMins[j][2] )
+				continue;
+			break;
+		}
+
+		if ( j == numMissiles ) {
+			skipped++;
+			continue;
+		}
+
+		G_TimeShiftClient( ent, ltime, qfalse, NULL );
+		shifted++;
+	}
+
+	G_CountTimeShifts( shifted, skipped );
+}
+
+
+/*
+================
+G_TimeShiftTime
+
+Decide what time to shift everyone back to for a shot by "ent"
+================
+*/
+static int G_TimeShiftTime( gentity_t *ent ) {
+	// if it's enabled server-side and the client wants it or wants it for this weapon
+	if ( g_unlagged.integer ) {
+		// full lag compensation
+		return ent->client->lastCmdTime;
+	}
+
+	// server frame lag compensation
+	return level.previousTime + ent->client->frameOffset;
+}
+
+
 /*
 ================
 G_DoTimeShiftFor
 
 Decide what time to shift everyone back to, and do it
+for everyone that can be hit by the shot from "start" to "end"
 ================
 */
-void G_DoTimeShiftFor( gentity_t *ent ) {	
+void G_DoTimeShiftFor( gentity_t *ent, const vec3_t start, const vec3_t end, float spread ) {
 	int time;
 
 	// don't time shift for mistakes or bots
@@ -182,16 +505,36 @@ void G_DoTimeShiftFor( gentity_t *ent ) {
 		return;
 	}
 
-	// if it's enabled server-side and the client wants it or wants it for this weapon
-	if ( g_unlagged.integer ) {
-		// full lag compensation
-		time = ent->client->lastCmdTime;
+	time = G_TimeShiftTime( ent );
+
+	if ( g_unlaggedBroadphase.integer ) {
+		G_TimeShiftClientsForShot( time, ent, start, end, spread );
 	} else {
-		// server frame lag compensation
-		time = level.previousTime + ent->client->frameOffset;
+		G_TimeShiftAllClients( time, ent );
+	}
+}
+
+
+/*
+================
+G_WidenTimeShiftFor
+
+The shot from G_DoTimeShiftFor has left its culled ray or cone, e.g. it
+bounced off an invulnerability sphere, so shift everyone else too.
+Clients that are already shifted stay where they are, and a single
+G_UndoTimeShiftFor still puts them all back.
+================
+*/
+void G_WidenTimeShiftFor( gentity_t *ent ) {
+
+	// don't time shift for mistakes or bots
+	if ( !ent->inuse || !ent->client || (ent->r.svFlags & SVF_BOT) ) {
+		return;
 	}
 
-	G_TimeShiftAllClients( time, ent );
+	if ( g_unlaggedBroadphase.integer ) {
+		G_TimeShiftAllClients( G_TimeShiftTime( ent ), ent );
+	}
 }
 
 
@@ -212,7 +555,7 @@ void G_UnTimeShiftClient( gentity_t *ent ) {
 		ent->client->saved.leveltime = 0;
 
 		// this will recalculate absmin and absmax
-		trap_LinkEntity( ent );
+		G_LinkEntity( ent );
 	}
 }
 
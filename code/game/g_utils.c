@@ -55,13 +55,117 @@ model / sound configstring indexes
 =========================================================================
 */
 
+/*
+Model and sound configstrings are mirrored in hashed tables, so that
+index lookups don't have to fetch every configstring from the server.
+The game is the only writer of these ranges, the tables are filled from
+the server on map load (a map_restart keeps the old indexes) and updated
+whenever a new index is created.
+*/
+
+#define CS_INDEX_HASH_SIZE	256
+
+typedef struct {
+	int		start;
+	int		max;
+	int		count;								// next unused index
+	char	names[ MAX_MODELS ][ MAX_QPATH ];	// MAX_SOUNDS is the same
+	int		hashNext[ MAX_MODELS ];
+	int		hashTable[ CS_INDEX_HASH_SIZE ];
+} csIndexTable_t;
+
+static csIndexTable_t csModels;
+static csIndexTable_t csSounds;
+
+// g_configstringStats
+static int	csLookups;
+static int	csHits;
+static int	csSyscalls;
+
+
+/*
+================
+G_IndexHash
+================
+*/
+static int G_IndexHash( const char *name ) {
+	unsigned int hash;
+
+	hash = 0;
+	while ( *name ) {
+		hash = hash * 31 + (unsigned char)*name;
+		name++;
+	}
+
+	return hash & ( CS_INDEX_HASH_SIZE - 1 );
+}
+
+
+/*
+================
+G_AddIndex
+================
+*/
+static void G_AddIndex( csIndexTable_t *table, int index, const char *name ) {
+	int hash;
+
+	Q_strncpyz( table->names[ index ], name, sizeof( table->names[ index ] ) );
+	hash = G_IndexHash( name );
+	table->hashNext[ index ] = table->hashTable[ hash ];
+	table->hashTable[ hash ] = index;
+}
+
+
+/*
+================
+G_InitIndexTable
+================
+*/
+static void G_InitIndexTable( csIndexTable_t *table, int start, int max ) {
+	char	s[MAX_STRING_CHARS];
+	int		i;
+
+	memset( table->hashTable, 0, sizeof( table->hashTable ) );
+	table->start = start;
+	table->max = max;
+
+	for ( i = 1 ; i < max ; i++ ) {
+		trap_GetConfigstring( start + i, s, sizeof( s ) );
+		csSyscalls++;
+		if ( !s[0] ) {
+			break;
+		}
+		G_AddIndex( table, i, s );
+	}
+
+	table->count = i;
+}
+
+
+/*
+================
+G_InitConfigstringIndexes
+
+Called on map load, before any index is registered
+================
+*/
+void G_InitConfigstringIndexes( void ) {
+	csLookups = 0;
+	csHits = 0;
+	csSyscalls = 0;
+
+	G_InitIndexTable( &csModels, CS_MODELS, MAX_MODELS );
+	G_InitIndexTable( &csSounds, CS_SOUNDS, MAX_SOUNDS );
+}
+
+
 /*
 ================
 G_FindConfigstringIndex
 
 ================
 */
-int G_FindConfigstringIndex( const char *name, int start, int max, qboolean create ) {
+static int G_FindConfigstringIndex( csIndexTable_t *table, const char *name, qboolean create ) {
 	int		i;
 	char	s[MAX_STRING_CHARS];
 
@@ -69,13 +173,23 @@ int G_FindConfigstringIndex( const char *name, int start, int max, qboolean crea
 		return 0;
 	}
 
-	for ( i=1 ; i<max ; i++ ) {
-		trap_GetConfigstring( start + i, s, sizeof( s ) );
-		if ( !s[0] ) {
-			break;
+	csLookups++;
+
+	if ( strlen( name ) < MAX_QPATH ) {
+		for ( i = table->hashTable[ G_IndexHash( name ) ] ; i ; i = table->hashNext[ i ] ) {
+			if ( !strcmp( table->names[ i ], name ) ) {
+				csHits++;
+				return i;
+			}
 		}
-		if ( !strcmp( s, name ) ) {
-			return i;
+	} else {
+		// only a truncated copy is in the table, compare the configstrings
+		for ( i = 1 ; i < table->count ; i++ ) {
+			trap_GetConfigstring( table->start + i, s, sizeof( s ) );
+			csSyscalls++;
+			if ( !strcmp( s, name ) ) {
+				return i;
+			}
 		}
 	}
 
@@ -83,22 +197,39 @@ int G_FindConfigstringIndex( const char *name, int start, int max, qboolean crea
 		return 0;
 	}
 
-	if ( i == max ) {
+	i = table->count;
+	if ( i == table->max ) {
 		G_Error( "G_FindConfigstringIndex: overflow" );
 	}
 
-	trap_SetConfigstring( start + i, name );
+	trap_SetConfigstring( table->start + i, name );
+	csSyscalls++;
+
+	G_AddIndex( table, i, name );
+	table->count++;
 
 	return i;
 }
 
 
 int G_ModelIndex( const char *name ) {
-	return G_FindConfigstringIndex (name, CS_MODELS, MAX_MODELS, qtrue);
+	return G_FindConfigstringIndex( &csModels, name, qtrue );
 }
 
 int G_SoundIndex( const char *name ) {
-	return G_FindConfigstringIndex (name, CS_SOUNDS, MAX_SOUNDS, qtrue);
+	return G_FindConfigstringIndex( &csSounds, name, qtrue );
+}
+
+
+/*
+================
+Svcmd_ConfigstringStats_f
+================
+*/
+void Svcmd_ConfigstringStats_f( void ) {
+	G_Printf( "Model indexes: %i of %i\n", csModels.count - 1, MAX_MODELS - 1 );
+	G_Printf( "Sound indexes: %i of %i\n", csSounds.count - 1, MAX_SOUNDS - 1 );
+	G_Printf( "Lookups: %i, %i found in table, %i configstring syscalls\n", csLookups, csHits, csSyscalls );
 }
 
 //=====================================================================
@@ -124,6 +255,165 @@ void G_TeamCommand( team_t team, const char *cmd ) {
 }
 
 
+/*
+=========================================================================
+
+entity names
+
+Every entity in use with a targetname or a team is kept on a chain for
+that name, in entity number order, so firing targets and building mover
+teams only visit the entities that carry the name.  The names are
+interned strings, targetnames with G_NewName so that they still match
+ignoring case, the chains are hashed by pointer and entries are told
+apart by comparing pointers.  G_SpawnGEntityFromSpawnVars, G_FindTeams
+and G_FreeEntity keep the chains up to date with G_UpdateEntityNames.
+
+=========================================================================
+*/
+
+#define ENTITY_NAME_HASH_SIZE	256
+
+typedef struct {
+	int			fieldofs;
+	const char	*(*findName)( const char *name );		// G_FindName or G_FindString
+	int			hashTable[ ENTITY_NAME_HASH_SIZE ];		// -1 if empty
+	int			hashNext[ MAX_GENTITIES ];
+	const char	*key[ MAX_GENTITIES ];					// name the entity is chained under
+	int			numLinked;
+} entityNameMap_t;
+
+static entityNameMap_t targetnameMap;
+static entityNameMap_t teamMap;
+
+
+/*
+================
+G_NameHash
+
+Interned strings are separate level allocations at least 32 bytes apart
+================
+*/
+static int G_NameHash( const char *name ) {
+	return (int)( ( (unsigned int)(intptr_t)name >> 5 ) & ( ENTITY_NAME_HASH_SIZE - 1 ) );
+}
+
+
+static void G_ClearNameMap( entityNameMap_t *map, int fieldofs, const char *(*findName)( const char *name ) ) {
+	memset( map, 0, sizeof( *map ) );
+	memset( map->hashTable, -1, sizeof( map->hashTable ) );
+	map->fieldofs = fieldofs;
+	map->findName = findName;
+}
+
+
+/*
+================
+G_UpdateName
+
+Moves the entity to the chain of the name it holds now
+================
+*/
+static void G_UpdateName( entityNameMap_t *map, gentity_t *ent ) {
+	const char	*key;
+	int			num, *link;
+
+	num = ent - g_entities;
+	key = ent->inuse ? *(const char **)( (byte *)ent + map->fieldofs ) : NULL;
+	if ( key == map->key[ num ] ) {
+		return;
+	}
+
+	if ( map->key[ num ] ) {
+		link = &map->hashTable[ G_NameHash( map->key[ num ] ) ];
+		while ( *link != num ) {
+			link = &map->hashNext[ *link ];
+		}
+		*link = map->hashNext[ num ];
+		map->key[ num ] = NULL;
+		map->numLinked--;
+	}
+
+	if ( key ) {
+		link = &map->hashTable[ G_NameHash( key ) ];
+		while ( *link != -1 && *link < num ) {
+			link = &map->hashNext[ *link ];
+		}
+		map->hashNext[ num ] = *link;
+		*link = num;
+		map->key[ num ] = key;
+		map->numLinked++;
+	}
+}
+
+
+void G_UpdateEntityNames( gentity_t *ent ) {
+	G_UpdateName( &targetnameMap, ent );
+	G_UpdateName( &teamMap, ent );
+}
+
+
+/*
+================
+G_NextNamed
+
+Returns the next entity after from that holds name, the same one G_Find
+would return.  from doesn't have to hold name itself, or even be in use,
+so callers can keep going after the last result was freed or renamed.
+================
+*/
+static gentity_t *G_NextNamed( entityNameMap_t *map, gentity_t *from, const char *name ) {
+	int num, start;
+
+	if ( from && map->key[ from - g_entities ] == name ) {
+		num = map->hashNext[ from - g_entities ];
+	} else {
+		name = name ? map->findName( name ) : NULL;
+		if ( !name ) {
+			return NULL;
+		}
+		start = from ? from - g_entities : -1;
+		num = map->hashTable[ G_NameHash( name ) ];
+		while ( num != -1 && num <= start ) {
+			num = map->hashNext[ num ];
+		}
+	}
+
+	for ( ; num != -1; num = map->hashNext[ num ] ) {
+		if ( map->key[ num ] == name ) {
+			return &g_entities[ num ];
+		}
+	}
+
+	return NULL;
+}
+
+
+/*
+================
+G_NextTarget
+
+Iterates the entities with a targetname, start with from NULL:
+
+for ( t = G_NextTarget( NULL, name ); t; t = G_NextTarget( t, name ) )
+================
+*/
+gentity_t *G_NextTarget( gentity_t *from, const char *targetname ) {
+	return G_NextNamed( &targetnameMap, from, targetname );
+}
+
+
+/*
+================
+G_NextTeamMember
+
+Iterates the entities with a mover or item team the same way
+================
+*/
+gentity_t *G_NextTeamMember( gentity_t *from, const char *team ) {
+	return G_NextNamed( &teamMap, from, team );
+}
+
+
 /*
 =============
 G_Find
@@ -134,12 +424,23 @@ the matching string at fieldofs (use the FOFS() macro) in the structure.
 Searches beginning at the entity after from, or the beginning if NULL
 NULL will be returned if the end of the list is reached.
 
+The target, targetname and team fields hold interned strings and are
+matched by pointer, targetname and team through the entity name chains.
+target and targetname still match ignoring case like everything else,
+team exactly.
 =============
 */
 gentity_t *G_Find (gentity_t *from, int fieldofs, const char *match)
 {
 	const gentity_t *to;
-	char	*s;
+	const char	*s;
+
+	if ( fieldofs == FOFS(targetname) ) {
+		return G_NextTarget( from, match );
+	}
+	if ( fieldofs == FOFS(team) ) {
+		return G_NextTeamMember( from, match );
+	}
 
 	if (!from)
 		from = g_entities;
@@ -148,11 +449,24 @@ gentity_t *G_Find (gentity_t *from, int fieldofs, const char *match)
 
 	to = &g_entities[ level.num_entities ];
 
+	if ( fieldofs == FOFS(target) ) {
+		match = match ? G_FindName( match ) : NULL;
+		if ( !match ) {
+			return NULL;
+		}
+		for ( ; from < to ; from++ ) {
+			if ( from->inuse && *(const char **)((byte *)from + fieldofs) == match ) {
+				return from;
+			}
+		}
+		return NULL;
+	}
+
 	for ( ; from < to ; from++ )
 	{
 		if (!from->inuse)
 			continue;
-		s = *(char **) ((byte *)from + fieldofs);
+		s = *(const char **) ((byte *)from + fieldofs);
 		if (!s)
 			continue;
 		if (!Q_stricmp (s, match))
@@ -188,7 +502,7 @@ gentity_t *G_PickTarget( const char *targetname )
 	num_choices = 0;
 	while(1)
 	{
-		ent = G_Find (ent, FOFS(targetname), targetname);
+		ent = G_NextTarget (ent, targetname);
 		if (!ent)
 			break;
 		choice[num_choices++] = ent;
@@ -236,7 +550,7 @@ void G_UseTargets( gentity_t *ent, gentity_t *activator ) {
 	}
 
 	t = NULL;
-	while ( (t = G_Find (t, FOFS(targetname), ent->target)) != NULL ) {
+	while ( (t = G_NextTarget (t, ent->target)) != NULL ) {
 		if ( t == ent ) {
 			G_Printf ("WARNING: Entity used itself.\n");
 		} else {
@@ -350,119 +664,932 @@ float vectoyaw( const vec3_t vec ) {
 }
 
 
-void G_InitGentity( gentity_t *e ) {
-	e->inuse = qtrue;
-	e->classname = "noclass";
-	e->s.number = e - g_entities;
-	e->r.ownerNum = ENTITYNUM_NONE;
-	e->tag = TAG_NONE;
-}
+/*
+=========================================================================
 
+think scheduler
 
-/*
-=================
-G_Spawn
+Entities with a pending think are kept in a binary heap ordered by
+nextthink, so G_RunFrame only has to visit the ones that are due.
+ent->nextthink can still be read directly, but it has to be written
+through G_SetNextThink to keep the heap in sync.
 
-Either finds a free entity, or allocates a new one.
+=========================================================================
+*/
 
-  The slots from 0 to MAX_CLIENTS-1 are always reserved for clients, and will
-never be used by anything else.
+typedef struct {
+	int		heap[MAX_GENTITIES];	// entity numbers, earliest think first
+	int		pos[MAX_GENTITIES];		// heap position of each entity, -1 if none
+	int		time[MAX_GENTITIES];	// nextthink the entity was scheduled with
+	int		count;
+} thinkQueue_t;
 
-Try to avoid reusing an entity that was recently freed, because it
-can cause the client to think the entity morphed into something else
-instead of being removed and recreated, which can cause interpolated
-angles and bad trails.
-=================
+static thinkQueue_t thinkQueue;
+
+
+/*
+================
+G_ThinkBefore
+
+Orders the heap by think time, then by entity number
+================
 */
-gentity_t *G_Spawn( void ) {
-	int			i, timeout;
-	gentity_t	*e;
+static qboolean G_ThinkBefore( int a, int b ) {
+	if ( thinkQueue.time[ a ] != thinkQueue.time[ b ] ) {
+		return thinkQueue.time[ a ] < thinkQueue.time[ b ];
+	}
+	return a < b;
+}
 
-	e = NULL; // shut up warning
-	// try to release oldest items first
-	for ( timeout = 1000 ; timeout >= 0 ; timeout -= 250 ) {
-		// if we go through all entities and can't find one to free,
-		// override the normal minimum times before use
-		e = &g_entities[ MAX_CLIENTS ];
-		for ( i = MAX_CLIENTS ; i < level.num_entities; i++, e++ ) {
-			if ( e->inuse ) {
-				continue;
-			}
 
-			// the first couple seconds of server time can involve a lot of
-			// freeing and allocating, so relax the replacement policy
-			if ( e->freetime > level.startTime + 2000 && level.time - e->freetime < timeout ) {
-				continue;
-			}
+static void G_ThinkPlace( int num, int pos ) {
+	thinkQueue.heap[ pos ] = num;
+	thinkQueue.pos[ num ] = pos;
+}
 
-			// reuse this slot
-			G_InitGentity( e );
-			return e;
-		}
 
-		if ( level.num_entities < ENTITYNUM_MAX_NORMAL ) {
+static void G_ThinkSiftUp( int pos ) {
+	int num, parent;
+
+	num = thinkQueue.heap[ pos ];
+	while ( pos > 0 ) {
+		parent = ( pos - 1 ) >> 1;
+		if ( !G_ThinkBefore( num, thinkQueue.heap[ parent ] ) ) {
 			break;
 		}
+		G_ThinkPlace( thinkQueue.heap[ parent ], pos );
+		pos = parent;
 	}
+	G_ThinkPlace( num, pos );
+}
 
-	if ( i == ENTITYNUM_MAX_NORMAL ) {
-		for (i = 0; i < MAX_GENTITIES; i++) {
-			G_Printf("%4i: %s\n", i, g_entities[i].classname);
+
+static void G_ThinkSiftDown( int pos ) {
+	int num, child;
+
+	num = thinkQueue.heap[ pos ];
+	for ( ;; ) {
+		child = pos * 2 + 1;
+		if ( child >= thinkQueue.count ) {
+			break;
 		}
-		G_Error( "G_Spawn: no free entities" );
+		if ( child + 1 < thinkQueue.count && G_ThinkBefore( thinkQueue.heap[ child + 1 ], thinkQueue.heap[ child ] ) ) {
+			child++;
+		}
+		if ( !G_ThinkBefore( thinkQueue.heap[ child ], num ) ) {
+			break;
+		}
+		G_ThinkPlace( thinkQueue.heap[ child ], pos );
+		pos = child;
 	}
-	
-	// open up a new slot
-	level.num_entities++;
+	G_ThinkPlace( num, pos );
+}
 
-	// let the server system know that there are more entities
-	trap_LocateGameData( level.gentities, level.num_entities, sizeof( gentity_t ), 
-		&level.clients[0].ps, sizeof( level.clients[0] ) );
 
-	G_InitGentity( e );
-	return e;
+/*
+================
+G_UnscheduleThink
+================
+*/
+static void G_UnscheduleThink( int num ) {
+	int pos, last;
+
+	pos = thinkQueue.pos[ num ];
+	if ( pos < 0 ) {
+		return;
+	}
+
+	thinkQueue.pos[ num ] = -1;
+	thinkQueue.count--;
+	if ( pos == thinkQueue.count ) {
+		return;
+	}
+
+	// move the last entry into the hole and restore heap order
+	last = thinkQueue.heap[ thinkQueue.count ];
+	G_ThinkPlace( last, pos );
+	if ( pos > 0 && G_ThinkBefore( last, thinkQueue.heap[ ( pos - 1 ) >> 1 ] ) ) {
+		G_ThinkSiftUp( pos );
+	} else {
+		G_ThinkSiftDown( pos );
+	}
 }
 
 
 /*
-=================
-G_EntitiesFree
-=================
+================
+G_InitThinkQueue
+================
 */
-qboolean G_EntitiesFree( void ) {
-	int			i;
-	gentity_t	*e;
+static void G_InitThinkQueue( void ) {
+	int i;
 
-	e = &g_entities[MAX_CLIENTS];
-	for ( i = MAX_CLIENTS; i < level.num_entities; i++, e++) {
-		if ( e->inuse ) {
-			continue;
-		}
-		// slot available
-		return qtrue;
+	thinkQueue.count = 0;
+	for ( i = 0; i < MAX_GENTITIES; i++ ) {
+		thinkQueue.pos[ i ] = -1;
 	}
-	return qfalse;
 }
 
 
 /*
-=================
-G_FreeEntity
+================
+G_SetNextThink
 
-Marks the entity as free
-=================
+Sets ent->nextthink and (re)schedules the entity, 0 cancels the think
+================
 */
-void G_FreeEntity( gentity_t *ed ) {
-	trap_UnlinkEntity (ed);		// unlink from world
+void G_SetNextThink( gentity_t *ent, int time ) {
+	int num, pos;
 
-	if ( ed->neverFree ) {
+	ent->nextthink = time;
+	num = ent - g_entities;
+
+	if ( time <= 0 ) {
+		G_UnscheduleThink( num );
 		return;
 	}
 
-	memset (ed, 0, sizeof(*ed));
-	ed->classname = "freed";
-	ed->freetime = level.time;
-	ed->inuse = qfalse;
+	pos = thinkQueue.pos[ num ];
+	if ( pos < 0 ) {
+		pos = thinkQueue.count++;
+		thinkQueue.time[ num ] = time;
+		G_ThinkPlace( num, pos );
+		G_ThinkSiftUp( pos );
+	} else if ( time < thinkQueue.time[ num ] ) {
+		thinkQueue.time[ num ] = time;
+		G_ThinkSiftUp( pos );
+	} else if ( time > thinkQueue.time[ num ] ) {
+		thinkQueue.time[ num ] = time;
+		G_ThinkSiftDown( pos );
+	}
+}
+
+
+/*
+================
+G_PopDueThinks
+
+Removes every entity whose think is due from the queue and stores its
+number in list, in think time order.  Returns the number of entities.
+================
+*/
+int G_PopDueThinks( int *list ) {
+	int n, num;
+
+	n = 0;
+	while ( thinkQueue.count > 0 ) {
+		num = thinkQueue.heap[ 0 ];
+		if ( thinkQueue.time[ num ] > level.time ) {
+			break;
+		}
+		G_UnscheduleThink( num );
+		list[ n++ ] = num;
+	}
+
+	return n;
+}
+
+
+/*
+=========================================================================
+
+entity slot allocator
+
+Freed slots are queued in the order they were freed, so the head of the
+queue always holds the slot with the oldest freetime.  G_Spawn only has
+to look at the head to decide if a slot can be reused.
+
+=========================================================================
+*/
+
+#define MIN_REUSE_TIME		1000	// don't reuse slots freed less than this ago
+#define RELAXED_REUSE_TIME	2000	// reuse anything freed this early in the level
+
+typedef struct {
+	int		head;					// oldest free slot, -1 if empty
+	int		tail;					// most recently freed slot
+	int		next[MAX_GENTITIES];
+	int		prev[MAX_GENTITIES];
+	byte	queued[MAX_GENTITIES];
+	int		numQueued;
+
+	// entity numbers in use, kept sorted
+	int		active[MAX_GENTITIES];
+	byte	listed[MAX_GENTITIES];
+	int		numListed;
+	int		cursor;					// position of the last G_NextActiveEntity result
+
+	// entity numbers that had takedamage set, kept sorted
+	int		damageable[MAX_GENTITIES];
+	byte	damageListed[MAX_GENTITIES];
+	int		numDamageable;
+
+	// g_entityStats
+	int		numSpawned;				// G_Spawn calls
+	int		numOpened;				// new slots at the end of the list
+	int		numReused;				// slots taken from the free queue
+	int		numForced;				// reused before MIN_REUSE_TIME expired
+	int		numFreed;
+	int		numActive;				// non-client entities in use
+	int		peakActive;
+	int		minLatency;				// msec between free and reuse
+	int		maxLatency;
+	float	totalLatency;			// in seconds, to keep it from overflowing
+} entityAlloc_t;
+
+static entityAlloc_t entAlloc;
+
+static void G_ClearTriggerGrid( void );
+
+
+/*
+================
+G_QueueFreeSlot
+
+Appends a freed slot to the tail of the free queue
+================
+*/
+static void G_QueueFreeSlot( int num ) {
+	entAlloc.next[ num ] = -1;
+	entAlloc.prev[ num ] = entAlloc.tail;
+	if ( entAlloc.tail == -1 ) {
+		entAlloc.head = num;
+	} else {
+		entAlloc.next[ entAlloc.tail ] = num;
+	}
+	entAlloc.tail = num;
+	entAlloc.queued[ num ] = 1;
+	entAlloc.numQueued++;
+}
+
+
+/*
+================
+G_UnqueueFreeSlot
+
+Removes a slot from anywhere in the free queue
+================
+*/
+static void G_UnqueueFreeSlot( int num ) {
+	if ( !entAlloc.queued[ num ] ) {
+		return;
+	}
+
+	if ( entAlloc.prev[ num ] == -1 ) {
+		entAlloc.head = entAlloc.next[ num ];
+	} else {
+		entAlloc.next[ entAlloc.prev[ num ] ] = entAlloc.next[ num ];
+	}
+	if ( entAlloc.next[ num ] == -1 ) {
+		entAlloc.tail = entAlloc.prev[ num ];
+	} else {
+		entAlloc.prev[ entAlloc.next[ num ] ] = entAlloc.prev[ num ];
+	}
+
+	entAlloc.queued[ num ] = 0;
+	entAlloc.numQueued--;
+}
+
+
+/*
+================
+G_InitEntityAlloc
+
+Called on map load, after g_entities has been cleared
+================
+*/
+void G_InitEntityAlloc( void ) {
+	memset( &entAlloc, 0, sizeof( entAlloc ) );
+	entAlloc.head = -1;
+	entAlloc.tail = -1;
+
+	G_InitThinkQueue();
+	G_ClearTriggerGrid();
+	G_ClearNameMap( &targetnameMap, FOFS(targetname), G_FindName );
+	G_ClearNameMap( &teamMap, FOFS(team), G_FindString );
+}
+
+
+/*
+================
+G_ActivePosition
+
+Returns the position of the first listed entity number >= num
+================
+*/
+static int G_ActivePosition( int num ) {
+	int lo, hi, mid;
+
+	lo = 0;
+	hi = entAlloc.numListed;
+	while ( lo < hi ) {
+		mid = ( lo + hi ) >> 1;
+		if ( entAlloc.active[ mid ] < num ) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+
+/*
+================
+G_AddActiveEntity
+
+Must be called whenever an entity becomes inuse
+================
+*/
+void G_AddActiveEntity( gentity_t *ent ) {
+	int num, pos;
+
+	num = ent - g_entities;
+	if ( entAlloc.listed[ num ] ) {
+		return;
+	}
+
+	pos = G_ActivePosition( num );
+	memmove( entAlloc.active + pos + 1, entAlloc.active + pos, ( entAlloc.numListed - pos ) * sizeof( int ) );
+	entAlloc.active[ pos ] = num;
+	entAlloc.listed[ num ] = 1;
+	entAlloc.numListed++;
+}
+
+
+/*
+================
+G_RemoveActiveEntity
+
+Must be called whenever an entity stops being inuse
+================
+*/
+void G_RemoveActiveEntity( gentity_t *ent ) {
+	int num, pos;
+
+	num = ent - g_entities;
+	if ( !entAlloc.listed[ num ] ) {
+		return;
+	}
+
+	pos = G_ActivePosition( num );
+	entAlloc.numListed--;
+	memmove( entAlloc.active + pos, entAlloc.active + pos + 1, ( entAlloc.numListed - pos ) * sizeof( int ) );
+	entAlloc.listed[ num ] = 0;
+}
+
+
+/*
+================
+G_NextActiveEntity
+
+Returns the next entity in use after from in entity number order,
+or NULL when there are no more.  Pass NULL to start from the beginning.
+
+Entities may be spawned or freed between calls, including from itself,
+so it can drive the same loops that used to scan all of g_entities.
+================
+*/
+gentity_t *G_NextActiveEntity( gentity_t *from ) {
+	int num, pos;
+
+	if ( !from ) {
+		pos = 0;
+	} else {
+		num = from - g_entities;
+		pos = entAlloc.cursor;
+		if ( pos < entAlloc.numListed && entAlloc.active[ pos ] == num ) {
+			pos++;
+		} else {
+			// list changed or another loop ran in between
+			pos = G_ActivePosition( num + 1 );
+		}
+	}
+
+	if ( pos >= entAlloc.numListed ) {
+		return NULL;
+	}
+
+	entAlloc.cursor = pos;
+	return &g_entities[ entAlloc.active[ pos ] ];
+}
+
+
+/*
+================
+G_AddDamageable
+
+Must be called whenever ent->takedamage is set, entities that lost
+it or were freed are dropped by G_DamageablesInBox
+================
+*/
+void G_AddDamageable( gentity_t *ent ) {
+	int num, pos;
+
+	num = ent - g_entities;
+	if ( entAlloc.damageListed[ num ] ) {
+		return;
+	}
+
+	for ( pos = entAlloc.numDamageable; pos > 0 && entAlloc.damageable[ pos-1 ] > num; pos-- ) {
+		entAlloc.damageable[ pos ] = entAlloc.damageable[ pos-1 ];
+	}
+	entAlloc.damageable[ pos ] = num;
+	entAlloc.damageListed[ num ] = 1;
+	entAlloc.numDamageable++;
+}
+
+
+/*
+================
+G_DamageablesInBox
+
+Like trap_EntitiesInBox, but only returns linked entities that can take
+damage, in entity number order
+================
+*/
+int G_DamageablesInBox( const vec3_t mins, const vec3_t maxs, int *list, int maxcount ) {
+	gentity_t	*ent;
+	int			i, num, kept, count;
+
+	kept = count = 0;
+	for ( i = 0; i < entAlloc.numDamageable; i++ ) {
+		num = entAlloc.damageable[ i ];
+		ent = &g_entities[ num ];
+		if ( !ent->inuse || !ent->takedamage ) {
+			entAlloc.damageListed[ num ] = 0;
+			continue;
+		}
+		entAlloc.damageable[ kept++ ] = num;
+
+		if ( !ent->r.linked || count >= maxcount ) {
+			continue;
+		}
+		if ( ent->r.absmin[0] > maxs[0] || ent->r.absmin[1] > maxs[1] || ent->r.absmin[2] > maxs[2]
+			|| ent->r.absmax[0] < mins[0] || ent->r.absmax[1] < mins[1] || ent->r.absmax[2] < mins[2] ) {
+			continue;
+		}
+		list[ count++ ] = num;
+	}
+	entAlloc.numDamageable = kept;
+
+	return count;
+}
+
+
+void G_InitGentity( gentity_t *e ) {
+	int num = e - g_entities;
+
+	if ( num >= MAX_CLIENTS && !e->inuse ) {
+		G_UnqueueFreeSlot( num );
+		entAlloc.numActive++;
+		if ( entAlloc.numActive > entAlloc.peakActive ) {
+			entAlloc.peakActive = entAlloc.numActive;
+		}
+	}
+
+	e->inuse = qtrue;
+	G_AddActiveEntity( e );
+	e->classname = "noclass";
+	e->s.number = num;
+	e->r.ownerNum = ENTITYNUM_NONE;
+	e->tag = TAG_NONE;
+}
+
+
+/*
+=================
+G_Spawn
+
+Either finds a free entity, or allocates a new one.
+
+  The slots from 0 to MAX_CLIENTS-1 are always reserved for clients, and will
+never be used by anything else.
+
+Try to avoid reusing an entity that was recently freed, because it
+can cause the client to think the entity morphed into something else
+instead of being removed and recreated, which can cause interpolated
+angles and bad trails.
+=================
+*/
+gentity_t *G_Spawn( void ) {
+	int			i, latency;
+	gentity_t	*e;
+
+	entAlloc.numSpawned++;
+
+	// the oldest free slot is at the head, if it can't be
+	// reused yet then none of the others can either
+	if ( entAlloc.head != -1 ) {
+		e = &g_entities[ entAlloc.head ];
+		latency = level.time - e->freetime;
+
+		// the first couple seconds of server time can involve a lot of
+		// freeing and allocating, so relax the replacement policy
+		if ( e->freetime <= level.startTime + RELAXED_REUSE_TIME || latency >= MIN_REUSE_TIME
+			|| level.num_entities >= ENTITYNUM_MAX_NORMAL ) {
+			// if we can't open any more slots,
+			// override the normal minimum times before use
+			if ( latency < MIN_REUSE_TIME && e->freetime > level.startTime + RELAXED_REUSE_TIME ) {
+				entAlloc.numForced++;
+			}
+
+			if ( !entAlloc.numReused || latency < entAlloc.minLatency ) {
+				entAlloc.minLatency = latency;
+			}
+			if ( latency > entAlloc.maxLatency ) {
+				entAlloc.maxLatency = latency;
+			}
+			entAlloc.totalLatency += latency * 0.001f;
+			entAlloc.numReused++;
+
+			// reuse this slot
+			G_InitGentity( e );
+			return e;
+		}
+	}
+
+	if ( level.num_entities >= ENTITYNUM_MAX_NORMAL ) {
+		for (i = 0; i < MAX_GENTITIES; i++) {
+			G_Printf("%4i: %s\n", i, g_entities[i].classname);
+		}
+		G_Error( "G_Spawn: no free entities" );
+	}
+
+	// open up a new slot
+	e = &g_entities[ level.num_entities ];
+	level.num_entities++;
+	entAlloc.numOpened++;
+
+	// let the server system know that there are more entities
+	trap_LocateGameData( level.gentities, level.num_entities, sizeof( gentity_t ), 
+		&level.clients[0].ps, sizeof( level.clients[0] ) );
+
+	G_InitGentity( e );
+	return e;
+}
+
+
+/*
+=================
+G_EntitiesFree
+=================
+*/
+qboolean G_EntitiesFree( void ) {
+	return entAlloc.numQueued > 0;
+}
+
+
+/*
+=================
+G_FreeEntity
+
+Marks the entity as free
+=================
+*/
+void G_FreeEntity( gentity_t *ed ) {
+	int num;
+
+	trap_UnlinkEntity (ed);		// unlink from world
+
+	if ( ed->neverFree ) {
+		return;
+	}
+
+	num = ed - g_entities;
+	if ( num >= MAX_CLIENTS ) {
+		if ( ed->inuse ) {
+			entAlloc.numActive--;
+			entAlloc.numFreed++;
+		}
+		// keep the queue in freetime order
+		G_UnqueueFreeSlot( num );
+		G_QueueFreeSlot( num );
+	}
+
+	G_RemoveActiveEntity( ed );
+	G_UnscheduleThink( num );
+
+	memset (ed, 0, sizeof(*ed));
+	ed->classname = "freed";
+	ed->freetime = level.time;
+	ed->inuse = qfalse;
+	G_UpdateEntityNames( ed );
+}
+
+
+/*
+=========================================================================
+
+trigger grid
+
+G_TouchTriggers used to ask the server for every entity around each
+client on every usercmd, only to throw away everything that isn't a
+trigger.  Triggers hardly ever move, so the game keeps its own 2D grid
+of linked CONTENTS_TRIGGER entities by their absolute bounds.
+
+The grid is built on the first query of a level.  After that the game
+links entities through G_LinkEntity, which puts a trigger that isn't in
+the grid with its current bounds on a list of moved triggers that every
+query tests, until there are too many of them and the next query
+rebuilds the grid.  Every trigger sets its contents before it is linked,
+and trap_SetBrushModel only links entities while the map is spawned.  An
+entry that went stale (unlinked, picked up, freed or reused) costs
+nothing, every candidate is tested against its current state the same
+way trap_EntitiesInBox does.  Triggers that would cover too many cells
+are kept in a separate list that is always tested.
+
+=========================================================================
+*/
+
+#define TRIGGER_CELL_SIZE		256
+#define TRIGGER_GRID_SIZE		64		// cells per axis at most
+#define TRIGGER_MAX_SPAN		64		// cells a trigger may cover before it goes on the large list
+#define TRIGGER_MAX_ENTRIES		8192
+#define TRIGGER_MAX_MOVED		32		// moved triggers tested on their own before a rebuild
+
+typedef struct {
+	vec2_t	mins;
+	float	cellSize;
+	int		size[2];
+	int		cellStart[ TRIGGER_GRID_SIZE * TRIGGER_GRID_SIZE + 1 ];
+	int		entries[ TRIGGER_MAX_ENTRIES ];
+	int		large[ MAX_GENTITIES ];
+	int		numLarge;
+	int		numTriggers;
+
+	// linked since the build with bounds the cells don't cover
+	int		moved[ TRIGGER_MAX_MOVED ];
+	int		numMoved;
+	byte	isMoved[ MAX_GENTITIES ];
+
+	// bounds each trigger was indexed with
+	byte	indexed[ MAX_GENTITIES ];
+	vec3_t	absmin[ MAX_GENTITIES ];
+	vec3_t	absmax[ MAX_GENTITIES ];
+
+	// to list an entity only once per query
+	int		stamp[ MAX_GENTITIES ];
+	int		queryCount;
+
+	qboolean	valid;
+	int		numRebuilds;
+} triggerGrid_t;
+
+static triggerGrid_t trigGrid;
+
+
+static void G_ClearTriggerGrid( void ) {
+	memset( &trigGrid, 0, sizeof( trigGrid ) );
+}
+
+
+static qboolean G_IsLinkedTrigger( const gentity_t *ent ) {
+	return ent->inuse && ent->r.linked && ( ent->r.contents & CONTENTS_TRIGGER );
+}
+
+
+static void G_TriggerCells( const vec3_t absmin, const vec3_t absmax, int *cells ) {
+	int i, c;
+
+	for ( i = 0; i < 2; i++ ) {
+		c = (int)( ( absmin[i] - trigGrid.mins[i] ) / trigGrid.cellSize );
+		cells[i] = c < 0 ? 0 : ( c >= trigGrid.size[i] ? trigGrid.size[i] - 1 : c );
+		c = (int)( ( absmax[i] - trigGrid.mins[i] ) / trigGrid.cellSize );
+		cells[i+2] = c < 0 ? 0 : ( c >= trigGrid.size[i] ? trigGrid.size[i] - 1 : c );
+	}
+}
+
+
+/*
+================
+G_BuildTriggerGrid
+================
+*/
+static void G_BuildTriggerGrid( void ) {
+	static int	triggers[ MAX_GENTITIES ];
+	static int	fill[ TRIGGER_GRID_SIZE * TRIGGER_GRID_SIZE ];
+	gentity_t	*ent;
+	vec2_t		maxs;
+	float		extent;
+	int			i, x, y, num, total, numCells;
+	int			cells[4];
+
+	maxs[0] = maxs[1] = 0.0f;
+	trigGrid.numRebuilds++;
+	trigGrid.valid = qtrue;
+	trigGrid.numTriggers = 0;
+	trigGrid.numLarge = 0;
+	trigGrid.numMoved = 0;
+	memset( trigGrid.indexed, 0, sizeof( trigGrid.indexed ) );
+	memset( trigGrid.isMoved, 0, sizeof( trigGrid.isMoved ) );
+
+	for ( ent = G_NextActiveEntity( NULL ); ent; ent = G_NextActiveEntity( ent ) ) {
+		if ( !G_IsLinkedTrigger( ent ) ) {
+			continue;
+		}
+		num = ent - g_entities;
+		if ( !trigGrid.numTriggers ) {
+			trigGrid.mins[0] = ent->r.absmin[0];
+			trigGrid.mins[1] = ent->r.absmin[1];
+			maxs[0] = ent->r.absmax[0];
+			maxs[1] = ent->r.absmax[1];
+		}
+		for ( i = 0; i < 2; i++ ) {
+			if ( ent->r.absmin[i] < trigGrid.mins[i] )
+				trigGrid.mins[i] = ent->r.absmin[i];
+			if ( ent->r.absmax[i] > maxs[i] )
+				maxs[i] = ent->r.absmax[i];
+		}
+		triggers[ trigGrid.numTriggers++ ] = num;
+		trigGrid.indexed[ num ] = 1;
+		VectorCopy( ent->r.absmin, trigGrid.absmin[ num ] );
+		VectorCopy( ent->r.absmax, trigGrid.absmax[ num ] );
+	}
+
+	memset( trigGrid.cellStart, 0, sizeof( trigGrid.cellStart ) );
+
+	if ( !trigGrid.numTriggers ) {
+		trigGrid.size[0] = trigGrid.size[1] = 1;
+		trigGrid.cellSize = TRIGGER_CELL_SIZE;
+		return;
+	}
+
+	extent = maxs[0] - trigGrid.mins[0];
+	if ( maxs[1] - trigGrid.mins[1] > extent )
+		extent = maxs[1] - trigGrid.mins[1];
+	trigGrid.cellSize = TRIGGER_CELL_SIZE;
+	if ( extent / trigGrid.cellSize >= TRIGGER_GRID_SIZE )
+		trigGrid.cellSize = extent / TRIGGER_GRID_SIZE + 1.0f;
+	for ( i = 0; i < 2; i++ ) {
+		trigGrid.size[i] = (int)( ( maxs[i] - trigGrid.mins[i] ) / trigGrid.cellSize ) + 1;
+		if ( trigGrid.size[i] > TRIGGER_GRID_SIZE )
+			trigGrid.size[i] = TRIGGER_GRID_SIZE;
+	}
+	numCells = trigGrid.size[0] * trigGrid.size[1];
+
+	// count the entries of each cell
+	total = 0;
+	for ( i = 0; i < trigGrid.numTriggers; i++ ) {
+		num = triggers[i];
+		G_TriggerCells( trigGrid.absmin[ num ], trigGrid.absmax[ num ], cells );
+		if ( ( cells[2] - cells[0] + 1 ) * ( cells[3] - cells[1] + 1 ) > TRIGGER_MAX_SPAN
+			|| total + ( cells[2] - cells[0] + 1 ) * ( cells[3] - cells[1] + 1 ) > TRIGGER_MAX_ENTRIES ) {
+			trigGrid.large[ trigGrid.numLarge++ ] = num;
+			triggers[i] = -1;
+			continue;
+		}
+		for ( y = cells[1]; y <= cells[3]; y++ ) {
+			for ( x = cells[0]; x <= cells[2]; x++ ) {
+				trigGrid.cellStart[ y * trigGrid.size[0] + x + 1 ]++;
+				total++;
+			}
+		}
+	}
+
+	for ( i = 0; i < numCells; i++ ) {
+		trigGrid.cellStart[ i + 1 ] += trigGrid.cellStart[ i ];
+		fill[ i ] = trigGrid.cellStart[ i ];
+	}
+
+	// entity number order within each cell
+	for ( i = 0; i < trigGrid.numTriggers; i++ ) {
+		num = triggers[i];
+		if ( num == -1 ) {
+			continue;
+		}
+		G_TriggerCells( trigGrid.absmin[ num ], trigGrid.absmax[ num ], cells );
+		for ( y = cells[1]; y <= cells[3]; y++ ) {
+			for ( x = cells[0]; x <= cells[2]; x++ ) {
+				trigGrid.entries[ fill[ y * trigGrid.size[0] + x ]++ ] = num;
+			}
+		}
+	}
+}
+
+
+/*
+================
+G_LinkEntity
+
+trap_LinkEntity for the game code, tells the trigger grid about triggers
+that appear or move
+================
+*/
+void G_LinkEntity( gentity_t *ent ) {
+	int num;
+
+	trap_LinkEntity( ent );
+
+	if ( !trigGrid.valid || !( ent->r.contents & CONTENTS_TRIGGER ) ) {
+		return;
+	}
+
+	num = ent - g_entities;
+	if ( trigGrid.isMoved[ num ] ) {
+		return;
+	}
+	if ( trigGrid.indexed[ num ] && VectorCompare( ent->r.absmin, trigGrid.absmin[ num ] )
+		&& VectorCompare( ent->r.absmax, trigGrid.absmax[ num ] ) ) {
+		return;
+	}
+
+	if ( trigGrid.numMoved >= TRIGGER_MAX_MOVED ) {
+		trigGrid.valid = qfalse;
+		return;
+	}
+	trigGrid.moved[ trigGrid.numMoved++ ] = num;
+	trigGrid.isMoved[ num ] = 1;
+}
+
+
+static int G_AddTriggerInBox( int num, const vec3_t mins, const vec3_t maxs, int *list, int count, int maxcount ) {
+	gentity_t	*ent;
+	int			i;
+
+	if ( trigGrid.stamp[ num ] == trigGrid.queryCount || count >= maxcount ) {
+		return count;
+	}
+	trigGrid.stamp[ num ] = trigGrid.queryCount;
+
+	ent = &g_entities[ num ];
+	if ( !G_IsLinkedTrigger( ent ) ) {
+		return count;
+	}
+
+	if ( ent->r.absmin[0] > maxs[0] || ent->r.absmin[1] > maxs[1] || ent->r.absmin[2] > maxs[2]
+		|| ent->r.absmax[0] < mins[0] || ent->r.absmax[1] < mins[1] || ent->r.absmax[2] < mins[2] ) {
+		return count;
+	}
+
+	// keep the list in entity number order
+	for ( i = count; i > 0 && list[ i-1 ] > num; i-- ) {
+		list[ i ] = list[ i-1 ];
+	}
+	list[ i ] = num;
+
+	return count + 1;
+}
+
+
+/*
+================
+G_TriggersInBox
+
+Like trap_EntitiesInBox, but only returns linked CONTENTS_TRIGGER
+entities, in entity number order
+================
+*/
+int G_TriggersInBox( const vec3_t mins, const vec3_t maxs, int *list, int maxcount ) {
+	int		i, x, y, count;
+	int		cells[4];
+
+	if ( !trigGrid.valid ) {
+		G_BuildTriggerGrid();
+	}
+
+	trigGrid.queryCount++;
+	count = 0;
+
+	for ( i = 0; i < trigGrid.numLarge; i++ ) {
+		count = G_AddTriggerInBox( trigGrid.large[i], mins, maxs, list, count, maxcount );
+	}
+	for ( i = 0; i < trigGrid.numMoved; i++ ) {
+		count = G_AddTriggerInBox( trigGrid.moved[i], mins, maxs, list, count, maxcount );
+	}
+
+	G_TriggerCells( mins, maxs, cells );
+	for ( y = cells[1]; y <= cells[3]; y++ ) {
+		for ( x = cells[0]; x <= cells[2]; x++ ) {
+			for ( i = trigGrid.cellStart[ y * trigGrid.size[0] + x ]; i < trigGrid.cellStart[ y * trigGrid.size[0] + x + 1 ]; i++ ) {
+				count = G_AddTriggerInBox( trigGrid.entries[i], mins, maxs, list, count, maxcount );
+			}
+		}
+	}
+
+	return count;
+}
+
+
+/*
+=================
+Svcmd_EntityStats_f
+=================
+*/
+void Svcmd_EntityStats_f( void ) {
+	G_Printf( "Entity slots: %i of %i opened, %i free\n", level.num_entities, ENTITYNUM_MAX_NORMAL, entAlloc.numQueued );
+	G_Printf( "Active entities: %i (peak %i)\n", entAlloc.numActive, entAlloc.peakActive );
+	G_Printf( "Allocations: %i (%i new slots, %i reused, %i forced), %i freed\n",
+		entAlloc.numSpawned, entAlloc.numOpened, entAlloc.numReused, entAlloc.numForced, entAlloc.numFreed );
+	if ( entAlloc.numReused ) {
+		G_Printf( "Reuse latency: min %i, avg %i, max %i msec\n", entAlloc.minLatency,
+			(int)( entAlloc.totalLatency * 1000.0f / entAlloc.numReused ), entAlloc.maxLatency );
+	}
+	G_Printf( "Thinks: %i last frame (peak %i), %i scheduled\n", level.frameThinks, level.peakThinks, thinkQueue.count );
+	G_Printf( "Trigger grid: %i triggers (%i large, %i moved), %ix%i cells of %i, %i rebuilds\n", trigGrid.numTriggers, trigGrid.numLarge,
+		trigGrid.numMoved, trigGrid.size[0], trigGrid.size[1], (int)trigGrid.cellSize, trigGrid.numRebuilds );
+	G_Printf( "Entity names: %i targetnames, %i team members\n", targetnameMap.numLinked, teamMap.numLinked );
 }
 
 
@@ -491,7 +1618,7 @@ gentity_t *G_TempEntity( vec3_t origin, int event ) {
 	G_SetOrigin( e, snapped );
 
 	// find cluster for PVS
-	trap_LinkEntity( e );
+	G_LinkEntity( e );
 
 	return e;
 }
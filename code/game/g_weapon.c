@@ -187,7 +187,7 @@ static void Bullet_Fire( gentity_t *ent, float spread, int damage ) {
 	for ( i = 0; i < 10; i++ ) {
 
 		// unlagged
-		G_DoTimeShiftFor( ent );
+		G_DoTimeShiftFor( ent, muzzle_origin, end, 0 );
 
 		trap_Trace( &tr, muzzle_origin, NULL, NULL, end, passent, MASK_SHOT );
 
@@ -306,6 +306,8 @@ static qboolean ShotgunPellet( const vec3_t start, const vec3_t end, gentity_t *
 			if ( traceEnt->client && traceEnt->client->invulnerabilityTime > level.time ) {
 				if (G_InvulnerabilityEffect( traceEnt, forward, tr.endpos, impactpoint, bouncedir )) {
 					G_BounceProjectile( tr_start, impactpoint, bouncedir, tr_end );
+					// unlagged, the bounced pellet can hit clients outside the shifted cone
+					G_WidenTimeShiftFor( ent );
 					VectorCopy( impactpoint, tr_start );
 					// the player can hit him/herself with the bounced rail
 					passent = ENTITYNUM_NONE;
@@ -344,8 +346,9 @@ static void ShotgunPattern( const vec3_t origin, const vec3_t origin2, int seed,
 	PerpendicularVector( right, forward );
 	CrossProduct( forward, right, up );
 
-	// unlagged
-	G_DoTimeShiftFor( ent );
+	// unlagged, the corners of the square spread pattern are within this cone
+	VectorMA( origin, ( 8192.0 * 16.0 ), forward, end );
+	G_DoTimeShiftFor( ent, origin, end, DEFAULT_SHOTGUN_SPREAD * 16 * 1.415f );
 
 	// generate the "random" spread pattern
 	for ( i = 0 ; i < DEFAULT_SHOTGUN_COUNT ; i++ ) {
@@ -474,7 +477,7 @@ void weapon_railgun_fire( gentity_t *ent ) {
 	VectorMA( muzzle_origin, 8192.0, forward, end );
 
 	// unlagged
-	G_DoTimeShiftFor( ent );
+	G_DoTimeShiftFor( ent, muzzle_origin, end, 0 );
 
 	// trace only against the solids, so the railgun will go through people
 	unlinked = 0;
@@ -491,6 +494,8 @@ void weapon_railgun_fire( gentity_t *ent ) {
 			if ( traceEnt->client && traceEnt->client->invulnerabilityTime > level.time ) {
 				if ( G_InvulnerabilityEffect( traceEnt, forward, trace.endpos, impactpoint, bouncedir ) ) {
 					G_BounceProjectile( muzzle, impactpoint, bouncedir, end );
+					// unlagged, the bounced beam can hit clients outside the shifted ray
+					G_WidenTimeShiftFor( ent );
 					// snap the endpos to integers to save net bandwidth, but nudged towards the line
 					SnapVectorTowards( trace.endpos, muzzle );
 					// send railgun beam effect
@@ -532,7 +537,7 @@ void weapon_railgun_fire( gentity_t *ent ) {
 
 	// link back in any entities we unlinked
 	for ( i = 0 ; i < unlinked ; i++ ) {
-		trap_LinkEntity( unlinkedEntities[i] );
+		G_LinkEntity( unlinkedEntities[i] );
 	}
 
 	// the final trace endpos will be the terminal point of the rail trail
@@ -650,7 +655,7 @@ void Weapon_LightningFire( gentity_t *ent ) {
 		VectorMA( muzzle_origin, LIGHTNING_RANGE, forward, end );
 
 		// unlagged
-		G_DoTimeShiftFor( ent );
+		G_DoTimeShiftFor( ent, muzzle_origin, end, 0 );
 
 		trap_Trace( &tr, muzzle_origin, NULL, NULL, end, passent, MASK_SHOT );
 
@@ -1051,7 +1056,7 @@ static void KamikazeDamage( gentity_t *self ) {
 		G_FreeEntity( self );
 		return;
 	}
-	self->nextthink = level.time + 100;
+	G_SetNextThink( self, level.time + 100 );
 
 	// add earth quake effect
 	newangles[0] = crandom() * 2;
@@ -1109,11 +1114,11 @@ void G_StartKamikaze( gentity_t *ent ) {
 	explosion->kamikazeTime = level.time;
 
 	explosion->think = KamikazeDamage;
-	explosion->nextthink = level.time + 100;
+	G_SetNextThink( explosion, level.time + 100 );
 	explosion->count = 0;
 	VectorClear(explosion->movedir);
 
-	trap_LinkEntity( explosion );
+	G_LinkEntity( explosion );
 
 	if (ent->client) {
 		//